@@ -23,29 +23,71 @@
 #ifndef LIBGAMBIT_ARRAY_H
 #define LIBGAMBIT_ARRAY_H
 
+#include <cassert>
+#include <utility>
+
 namespace Gambit {
 
-/// A basic bounds-checked array
+/// \brief A basic bounds-checked array
+///
+/// The elements are stored contiguously.  Space is allocated in
+/// geometrically increasing amounts as elements are inserted, so that
+/// appending an element takes amortized constant time.
+///
+/// Each access by index is checked, and an IndexException is thrown if
+/// the index is out of range.  If GAMBIT_INDEX_ASSERTIONS is defined
+/// (see the --enable-index-assertions configure option), the check is
+/// a debug assertion instead, which is compiled out when NDEBUG is
+/// also defined.
 template <class T> class Array  {
 protected:
   int mindex, maxdex;
-  T *data;
+  /// The highest index for which space is allocated
+  int maxalloc;
+  T *m_data;
+
+  /// Allocates space for the indices mindex to p_last
+  T *Allocate(int p_last) const
+  { return (p_last >= mindex) ? new T[p_last - mindex + 1] - mindex : 0; }
+  /// Frees the space allocated for the elements
+  void Deallocate(void)
+  { if (m_data)  delete [] (m_data + mindex); }
+  /// Moves the value of an element, where the language supports it
+  static void Transfer(T &p_to, T &p_from)
+  {
+#if __cplusplus >= 201103L
+    p_to = std::move(p_from);
+#else
+    p_to = p_from;
+#endif  // __cplusplus
+  }
 
   /// Private helper function that accomplishes the insertion of an object
   int InsertAt(const T &t, int n)
   {
     if (this->mindex > n || n > this->maxdex + 1)  throw IndexException();
 
-    T *new_data = new T[++this->maxdex - this->mindex + 1] - this->mindex;
-
-    int i;
-    for (i = this->mindex; i <= n - 1; i++) new_data[i] = this->data[i];
-    new_data[i++] = t;
-    for (; i <= this->maxdex; i++) new_data[i] = this->data[i - 1];
-
-    if (this->data)   delete [] (this->data + this->mindex);
-    this->data = new_data;
-
+    if (this->maxdex == this->maxalloc) {
+      int length = this->maxdex - this->mindex + 1;
+      int last = this->mindex + ((length < 4) ? 4 : 2 * length) - 1;
+      T *new_data = Allocate(last);
+      // Copy t first, as it may be one of the elements being moved
+      new_data[n] = t;
+      for (int i = this->mindex; i < n; i++)  Transfer(new_data[i], m_data[i]);
+      for (int i = n; i <= this->maxdex; i++)  Transfer(new_data[i + 1], m_data[i]);
+      Deallocate();
+      m_data = new_data;
+      this->maxalloc = last;
+    }
+    else if (n <= this->maxdex) {
+      T value(t);
+      for (int i = this->maxdex; i >= n; i--)  Transfer(m_data[i + 1], m_data[i]);
+      Transfer(m_data[n], value);
+    }
+    else {
+      m_data[n] = t;
+    }
+    this->maxdex++;
     return n;
   }
 public:
@@ -85,23 +127,34 @@ public:
   //@{
   /// Constructs an array of length 'len', starting at '1'
   Array(unsigned int len = 0)
-    : mindex(1), maxdex(len), data((len) ? new T[len] - 1 : 0) { } 
+    : mindex(1), maxdex(len), maxalloc(len),
+      m_data((len) ? new T[len] - 1 : 0) { } 
   /// Constructs an array starting at lo and ending at hi
-  Array(int lo, int hi) : mindex(lo), maxdex(hi)
+  Array(int lo, int hi) : mindex(lo), maxdex(hi), maxalloc(hi)
   {
     if (maxdex + 1 < mindex)   throw RangeException();
-    data = (maxdex >= mindex) ? new T[maxdex -mindex + 1] - mindex : 0;
+    m_data = Allocate(maxdex);
   }
   /// Copy the contents of another array
   Array(const Array<T> &a)
-    : mindex(a.mindex), maxdex(a.maxdex),
-      data((maxdex >= mindex) ? new T[maxdex - mindex + 1] - mindex : 0)
+    : mindex(a.mindex), maxdex(a.maxdex), maxalloc(a.maxdex),
+      m_data(Allocate(a.maxdex))
   {
-    for (int i = mindex; i <= maxdex; i++)  data[i] = a.data[i];
+    for (int i = mindex; i <= maxdex; i++)  m_data[i] = a.m_data[i];
   }
+#if __cplusplus >= 201103L
+  /// Take over the contents of another array, leaving it empty
+  Array(Array<T> &&a)
+    : mindex(a.mindex), maxdex(a.maxdex), maxalloc(a.maxalloc),
+      m_data(a.m_data)
+  {
+    a.m_data = 0;
+    a.maxdex = a.maxalloc = a.mindex - 1;
+  }
+#endif  // __cplusplus
   /// Destruct and deallocates the array
   virtual ~Array()
-  { if (maxdex >= mindex)  delete [] (data + mindex); }
+  { Deallocate(); }
 
   /// Copy the contents of another array
   Array<T> &operator=(const Array<T> &a)
@@ -112,17 +165,31 @@ public:
       // _essential_ for the correctness of the PVector and DVector
       // assignment operator, since it assumes the value of data does
       // not change.
-      if (!data || (data && (mindex != a.mindex || maxdex != a.maxdex)))  {
-	if (data)   delete [] (data + mindex);
-	mindex = a.mindex;   maxdex = a.maxdex;
-	data = (maxdex >= mindex) ? new T[maxdex - mindex + 1] - mindex : 0;
+      if (!m_data || (m_data && (mindex != a.mindex || maxdex != a.maxdex)))  {
+	Deallocate();
+	mindex = a.mindex;   maxdex = maxalloc = a.maxdex;
+	m_data = Allocate(maxdex);
       }
       
-      for (int i = mindex; i <= maxdex; i++) data[i] = a.data[i];
+      for (int i = mindex; i <= maxdex; i++) m_data[i] = a.m_data[i];
     }
 
     return *this;
   }
+#if __cplusplus >= 201103L
+  /// Take over the contents of another array, leaving it empty
+  Array<T> &operator=(Array<T> &&a)
+  {
+    if (this != &a) {
+      Deallocate();
+      mindex = a.mindex;   maxdex = a.maxdex;   maxalloc = a.maxalloc;
+      m_data = a.m_data;
+      a.m_data = 0;
+      a.maxdex = a.maxalloc = a.mindex - 1;
+    }
+    return *this;
+  }
+#endif  // __cplusplus
 
   //@}
 
@@ -161,22 +228,30 @@ public:
   /// Access the index'th entry in the array
   const T &operator[](int index) const 
   {
+#ifdef GAMBIT_INDEX_ASSERTIONS
+    assert(index >= mindex && index <= maxdex);
+#else
     if (index < mindex || index > maxdex)  throw IndexException();
-    return data[index];
+#endif  // GAMBIT_INDEX_ASSERTIONS
+    return m_data[index];
   }
 
   /// Access the index'th entry in the array
   T &operator[](int index)
   {
+#ifdef GAMBIT_INDEX_ASSERTIONS
+    assert(index >= mindex && index <= maxdex);
+#else
     if (index < mindex || index > maxdex)  throw IndexException();
-    return data[index];
+#endif  // GAMBIT_INDEX_ASSERTIONS
+    return m_data[index];
   }
 
   /// Return the index at which a given element resides in the array.
   int Find(const T &t) const
   {
     int i;
-    for (i = this->mindex; i <= this->maxdex && this->data[i] != t; i++);
+    for (i = this->mindex; i <= this->maxdex && this->m_data[i] != t; i++);
     return (i <= this->maxdex) ? i : (mindex-1);
   } 
 
@@ -214,16 +289,10 @@ public:
   {
     if (n < this->mindex || n > this->maxdex) throw IndexException();
 
-    T ret(this->data[n]);
-    T *new_data = (--this->maxdex>=this->mindex) ? new T[this->maxdex-this->mindex+1] - this->mindex : 0;
-    
-    int i;
-    for (i = this->mindex; i < n; i++) new_data[i] = this->data[i];
-    for (; i <= this->maxdex; i++)     new_data[i] = this->data[i + 1];
-
-    delete [] (this->data + this->mindex);
-    this->data = new_data;
-
+    T ret(m_data[n]);
+    for (int i = n; i < this->maxdex; i++)  Transfer(m_data[i], m_data[i + 1]);
+    // Release anything held by the vacated element
+    m_data[this->maxdex--] = T();
     return ret;
   }
   //@}
@@ -240,23 +309,43 @@ public:
   /// Return the number of elements in the array container.
   size_t size(void) const  { return maxdex - mindex + 1; }
   /// Access first element.
-  const T &front(void) const { return data[mindex]; }
+  const T &front(void) const { return m_data[mindex]; }
   /// Access first element.
-  T &front(void)             { return data[mindex]; }
+  T &front(void)             { return m_data[mindex]; }
   /// Access last element.
-  const T &back(void) const  { return data[maxdex]; }
+  const T &back(void) const  { return m_data[maxdex]; }
   /// Access last element.
-  T &back(void)              { return data[maxdex]; }
-  
+  T &back(void)              { return m_data[maxdex]; }
+  /// \brief Access the elements as a contiguous block.
+  ///
+  /// The element at index i is at offset i - First() from the pointer
+  /// returned, which is invalidated by inserting elements.
+  T *data(void)             { return (m_data) ? m_data + mindex : 0; }
+  /// Access the elements as a contiguous block.
+  const T *data(void) const { return (m_data) ? m_data + mindex : 0; }
+  /// Return the number of elements for which space is allocated.
+  size_t capacity(void) const { return maxalloc - mindex + 1; }
+  /// Allocate space for at least n elements, without changing the contents.
+  void reserve(size_t n)
+  {
+    if (n <= capacity())  return;
+    T *new_data = Allocate(mindex + (int) n - 1);
+    for (int i = mindex; i <= maxdex; i++)  Transfer(new_data[i], m_data[i]);
+    Deallocate();
+    m_data = new_data;
+    maxalloc = mindex + (int) n - 1;
+  }
+
+
   /// Adds a new element at the end of the array container, after its
   /// current last element.
   void push_back(const T &val) { InsertAt(val, this->maxdex + 1); }
   /// Removes all elements from the array container (which are destroyed),
   /// leaving the container with a size of 0.
   void clear(void)  {
-    delete [] (this->data + this->mindex);
-    this->data = 0;
-    this->maxdex = this->mindex - 1;
+    Deallocate();
+    m_data = 0;
+    this->maxdex = this->maxalloc = this->mindex - 1;
   }
   ///@}
 };
@@ -27,6 +27,48 @@
 
 namespace Gambit {
 
+class CompiledGameTree;
+
+/// \brief The sequences of a player's actions in a tree game
+///
+/// Each node of the tree is reached by some sequence of actions of the
+/// player; nodes reached by the same sequence share an index here, and
+/// the strategies in a support which play every action of a sequence
+/// are listed with it.  The probability that a mixed strategy plays a
+/// sequence is then the sum of the probabilities of the strategies
+/// listed, which is how mixed strategies are converted to behavior.
+/// Building the table takes one pass over the tree, and time
+/// proportional to the number of strategies consistent with each
+/// sequence.
+class PlayerSequenceTable {
+private:
+  int m_player;
+  /// The sequence leading to each node, by position in the compiled tree
+  Array<int> m_sequence;
+  /// At the player's nodes, the sequence extending the node's own
+  /// sequence by the first action; the other actions follow in order
+  Array<int> m_next;
+  /// The strategies (indices into the support) which play each sequence;
+  /// sequence 0 is empty, and all strategies play it
+  std::vector<std::vector<int> > m_strategies;
+
+public:
+  PlayerSequenceTable(const CompiledGameTree &, const StrategySupportProfile &,
+		      int p_player);
+
+  int GetPlayer(void) const { return m_player; }
+  int NumSequences(void) const { return m_strategies.size(); }
+  /// Returns the sequence leading to the node at position p_node
+  int GetSequence(int p_node) const { return m_sequence[p_node]; }
+  /// Returns the sequence ending with the p_action'th action at the
+  /// player's node at position p_node
+  int GetSequence(int p_node, int p_action) const
+  { return m_next[p_node] + p_action - 1; }
+  /// Returns the strategies which play the sequence
+  const std::vector<int> &GetStrategies(int p_sequence) const
+  { return m_strategies[p_sequence]; }
+};
+
 ///
 /// MixedBehaviorProfile<T> implements a randomized behavior profile on
 /// an extensive game.
@@ -38,15 +80,20 @@ protected:
   mutable bool m_cacheValid;
 
   // structures for storing cached data: nodes
-  mutable Vector<T> m_realizProbs, m_beliefs, m_nvals, m_bvals;
+  mutable Vector<T> m_realizProbs, m_beliefs;
   mutable Matrix<T> m_nodeValues;
 
   // structures for storing cached data: information sets
   mutable PVector<T> m_infosetValues;
+  // realization probabilities, numbered as in CompiledGameTree
+  mutable Vector<T> m_infosetProbs;
 
   // structures for storing cached data: actions
   mutable DVector<T> m_actionValues;   // aka conditional payoffs
   mutable DVector<T> m_gripe;
+  // probabilities of all actions, including chance, numbered as in
+  // CompiledGameTree
+  mutable Vector<T> m_actionProbs;
 
   const T &ActionValue(const GameAction &act) const 
     { return m_actionValues(act->GetInfoset()->GetPlayer()->GetNumber(),
@@ -61,16 +108,27 @@ protected:
   //@{
   void GetPayoff(GameTreeNodeRep *, const T &, int, T &) const;
   
-  void ComputeSolutionDataPass2(const GameNode &node) const;
-  void ComputeSolutionDataPass1(const GameNode &node) const;
+  /// Returns the flattened structure of the game tree
+  const CompiledGameTree &GetTree(void) const;
+  /// Copies the probabilities of the actions at the infoset into m_actionProbs
+  void LoadActionProbs(const CompiledGameTree &, int p_infoset) const;
+  /// Computes the realization probability, beliefs, and values of the
+  /// infoset and its actions, from those of the nodes
+  void ComputeInfosetData(const CompiledGameTree &, int p_infoset) const;
+  void ComputeSolutionDataPass2(const CompiledGameTree &) const;
+  void ComputeSolutionDataPass1(const CompiledGameTree &) const;
   void ComputeSolutionData(void) const;
+  /// Brings computed values up to date after a change in the
+  /// probabilities of the actions at the infoset
+  void UpdateSolutionData(int p_infoset) const;
   //@}
 
   /// @name Converting mixed strategies to behavior
   //@{
-  void BehaviorStrat(int, GameTreeNodeRep *);
-  void RealizationProbs(const MixedStrategyProfile<T> &,
-			int pl, const Array<int> &, GameTreeNodeRep *);
+  /// Sets the behavior of each player to that induced by the mixed
+  /// profile, using a table of sequences for each player
+  void BehaviorStrat(const MixedStrategyProfile<T> &,
+		     const List<PlayerSequenceTable> &);
   //@}
 
 public:
@@ -82,6 +140,15 @@ public:
   MixedBehaviorProfile(const MixedStrategyProfile<T> &);
   ~MixedBehaviorProfile() { }
 
+  /// \brief Converts a list of mixed strategy profiles to behavior
+  ///
+  /// Converts each of the mixed strategy profiles, which must all be on
+  /// the same tree game, to the behavior profile it induces.  The
+  /// structure needed for the conversion is built once, and shared by
+  /// all the profiles with the same support.
+  static List<MixedBehaviorProfile<T> > 
+  FromMixedProfiles(const List<MixedStrategyProfile<T> > &);
+
   MixedBehaviorProfile<T> &operator=(const MixedBehaviorProfile<T> &);
   MixedBehaviorProfile<T> &operator=(const Vector<T> &p)
     { Invalidate(); Vector<T>::operator=(p); return *this;}
@@ -155,6 +222,21 @@ public:
   void Randomize(int p_denom);
   //@}
 
+  /// @name Incremental updating
+  //@{
+  /// \brief Sets the probabilities of the actions at an information set
+  ///
+  /// Sets the probabilities of the actions in the support at the
+  /// (personal) information set, given in the order of the support.
+  /// Unlike assigning to the entries of the profile, this does not
+  /// discard the values already computed.  Instead, only the realization
+  /// probabilities below the members of the information set, and the
+  /// values of the nodes on the paths leading to them, are recomputed.
+  /// This makes it suitable for methods which change the profile one
+  /// information set at a time.
+  void SetActionProbs(const GameInfoset &p_infoset, const Vector<T> &p_probs);
+  //@}
+
   /// @name General data access
   //@{
   int Length(void) const { return Array<T>::Length(); }
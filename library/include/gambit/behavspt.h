@@ -23,6 +23,7 @@
 #ifndef LIBGAMBIT_BEHAVSPT_H
 #define LIBGAMBIT_BEHAVSPT_H
 
+#include <map>
 #include "game.h"
 
 namespace Gambit {
@@ -39,8 +40,8 @@ protected:
   Game m_efg;
   Array<Array<Array<GameAction> > > m_actions;
 
-  Array<List<bool> > m_infosetActive;
-  Array<List<List<bool> > > m_nonterminalActive;
+  Array<Array<bool> > m_infosetActive;
+  Array<Array<Array<bool> > > m_nonterminalActive;
 
   void activate(const GameNode &);
   void deactivate(const GameNode &);
@@ -161,6 +162,116 @@ public:
   //@}
 };
 
+/// \brief The sequence form of a tree game with perfect recall
+///
+/// A sequence of a player is a list of the player's own actions which
+/// leads to some node; with perfect recall, the members of an
+/// information set are all reached by the same sequence.  The
+/// sequences of each player are numbered from 1, starting with the
+/// empty sequence, followed by the sequences ending at each information
+/// set reachable in the support, in order of the information sets'
+/// numbers and then of the actions in the support.
+///
+/// The constraint matrix of a player has a row for the empty sequence,
+/// with a one in its column, and a row for each reachable information
+/// set, with a one in the column of the sequence leading to the
+/// information set and a minus one in the column of each sequence
+/// ending there.  Rather than storing it, this is described by
+/// GetParentSequence() and GetSequence().
+///
+/// The payoff tables are stored sparsely, as a list of the profiles of
+/// sequences which reach some node with an outcome, along with the
+/// payoffs of the outcomes weighted by their probabilities under chance.
+/// The size of the sequence form therefore grows linearly with the
+/// size of the tree, rather than with the product of the numbers of
+/// sequences.
+class SequenceForm {
+private:
+  BehaviorSupportProfile m_support;
+  /// The reachable information sets of each player, by number
+  Array<Array<GameInfoset> > m_infosets;
+  /// The index of each information set among those reachable, or zero
+  PVector<int> m_infosetIndex;
+  /// For each reachable information set, the sequence leading to it,
+  /// and the sequence before the first one ending there
+  Array<Array<int> > m_parent, m_offset;
+  /// For each sequence, the index of the information set where it ends,
+  /// and the index of its last action in the support (zero if empty)
+  Array<Array<int> > m_sequenceInfoset, m_sequenceAction;
+  /// The profile of sequences of each entry of the payoff tables,
+  /// laid out contiguously, as are the payoffs to each player
+  std::vector<int> m_entrySequences;
+  std::vector<Rational> m_entryPayoffs, m_entryProbs;
+
+  /// Collects the outcomes reached in the subtree rooted at p_node,
+  /// with probability p_prob under chance and sequences p_sequences, by
+  /// the (reversed) profile of sequences reaching them
+  void BuildEntries(const GameNode &p_node, const Rational &p_prob,
+		    std::vector<int> &p_sequences,
+		    std::map<std::vector<int>, int> &p_entries);
+
+public:
+  /// @name Lifecycle
+  //@{
+  /// Builds the sequence form of the game restricted to the support.
+  /// Throws an UndefinedException if the game is not a tree with
+  /// perfect recall.
+  SequenceForm(const BehaviorSupportProfile &);
+  //@}
+
+  /// @name Sequences and information sets
+  //@{
+  const BehaviorSupportProfile &GetSupport(void) const { return m_support; }
+  int NumPlayers(void) const { return m_infosets.Length(); }
+  /// Returns the number of sequences of the player
+  int NumSequences(int pl) const { return m_sequenceInfoset[pl].Length(); }
+  /// Returns the number of reachable information sets of the player
+  int NumInfosets(int pl) const { return m_infosets[pl].Length(); }
+  /// Returns the p_index'th reachable information set of the player
+  const GameInfoset &GetInfoset(int pl, int p_index) const
+  { return m_infosets[pl][p_index]; }
+  /// Returns the index of the information set among those reachable
+  /// by its player, or zero if it is not reachable
+  int GetInfosetIndex(const GameInfoset &p_infoset) const
+  { return m_infosetIndex(p_infoset->GetPlayer()->GetNumber(),
+			  p_infoset->GetNumber()); }
+  /// Returns the sequence leading to the p_index'th information set
+  int GetParentSequence(int pl, int p_index) const
+  { return m_parent[pl][p_index]; }
+  /// Returns the sequence ending with the p_action'th action in the
+  /// support at the p_index'th information set
+  int GetSequence(int pl, int p_index, int p_action) const
+  { return m_offset[pl][p_index] + p_action; }
+  /// Returns the index of the information set at which the sequence
+  /// ends, or zero for the empty sequence
+  int GetSequenceInfoset(int pl, int p_sequence) const
+  { return m_sequenceInfoset[pl][p_sequence]; }
+  /// Returns the index in the support of the last action of the
+  /// sequence, or zero for the empty sequence
+  int GetSequenceAction(int pl, int p_sequence) const
+  { return m_sequenceAction[pl][p_sequence]; }
+  //@}
+
+  /// @name Payoff tables
+  //@{
+  /// Returns the number of profiles of sequences reaching an outcome
+  int NumEntries(void) const { return m_entryProbs.size(); }
+  /// Returns the sequence of the player in the p_entry'th profile.
+  /// Profiles are listed in order of the sequence of the last player,
+  /// then of the next-to-last, and so on.
+  int GetEntrySequence(int p_entry, int pl) const
+  { return m_entrySequences[(p_entry - 1) * NumPlayers() + pl - 1]; }
+  /// Returns the sum of the payoffs to the player of the outcomes
+  /// reached by the profile, weighted by their probabilities
+  const Rational &GetEntryPayoff(int p_entry, int pl) const
+  { return m_entryPayoffs[(p_entry - 1) * NumPlayers() + pl - 1]; }
+  /// Returns the sum of the probabilities of the nodes with outcomes
+  /// reached by the profile
+  const Rational &GetEntryProb(int p_entry) const
+  { return m_entryProbs[p_entry - 1]; }
+  //@}
+};
+
 } // end namespace Gambit
 
 #endif  // LIBGAMBIT_BEHAVSPT_H
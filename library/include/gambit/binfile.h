@@ -0,0 +1,189 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/binfile.h
+// Low-level reading and writing of the binary game file format
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef LIBGAMBIT_BINFILE_H
+#define LIBGAMBIT_BINFILE_H
+
+#include <stdint.h>
+#include <cstring>
+#include <iostream>
+
+#include "gambit/gambit.h"
+
+namespace Gambit {
+
+//
+// A binary game file starts with an eight-byte signature, followed by
+// three 32-bit words: the format version, a byte-order mark, and the
+// kind of game (table or tree).  All numbers are then written in the
+// byte order of the machine which wrote the file; a file written on a
+// machine with the other byte order is rejected rather than converted.
+// Strings are written as a 32-bit length followed by their bytes, and
+// arrays of numbers as a contiguous block, so that they can be copied
+// directly into the payoff columns of a game when read.
+//
+
+/// The signature at the start of every binary game file
+const char BINARY_FILE_SIGNATURE[] = "\211GBG\r\n\032\n";
+/// The length of the signature, in bytes
+const size_t BINARY_FILE_SIGNATURE_LENGTH = 8;
+/// The version of the format written by this library
+const uint32_t BINARY_FILE_VERSION = 1;
+/// The byte-order mark, as written by this machine
+const uint32_t BINARY_FILE_BYTE_ORDER = 0x01020304;
+
+/// The kinds of game which can be stored in a binary file
+enum BinaryGameKind {
+  BINARY_GAME_TABLE = 1,
+  BINARY_GAME_TREE = 2
+};
+
+/// Returns true if the buffer begins with the binary file signature
+inline bool IsBinaryGameFile(const char *p_begin, const char *p_end)
+{
+  return ((size_t) (p_end - p_begin) >= BINARY_FILE_SIGNATURE_LENGTH &&
+	  memcmp(p_begin, BINARY_FILE_SIGNATURE,
+		 BINARY_FILE_SIGNATURE_LENGTH) == 0);
+}
+
+/// Writes the primitive items of a binary game file to a stream
+class BinaryFileWriter {
+private:
+  std::ostream &m_stream;
+
+public:
+  BinaryFileWriter(std::ostream &p_stream) : m_stream(p_stream) { }
+
+  /// Writes the signature and header for a game of the given kind
+  void WriteHeader(BinaryGameKind p_kind)
+  {
+    m_stream.write(BINARY_FILE_SIGNATURE, BINARY_FILE_SIGNATURE_LENGTH);
+    Write<uint32_t>(BINARY_FILE_VERSION);
+    Write<uint32_t>(BINARY_FILE_BYTE_ORDER);
+    Write<uint32_t>(p_kind);
+  }
+
+  /// Writes a single number
+  template <class T> void Write(const T &p_value)
+  { m_stream.write((const char *) &p_value, sizeof(T)); }
+  /// Writes a contiguous block of p_count numbers
+  template <class T> void WriteArray(const T *p_values, size_t p_count)
+  { if (p_count > 0) m_stream.write((const char *) p_values, p_count * sizeof(T)); }
+  /// Writes a count of items, as read by BinaryFileReader::ReadCount()
+  void WriteCount(size_t p_count)  { Write<uint64_t>(p_count); }
+  /// Writes a string, preceded by its length
+  void WriteString(const std::string &p_value)
+  {
+    Write<uint32_t>(p_value.length());
+    m_stream.write(p_value.data(), p_value.length());
+  }
+};
+
+/// \brief Reads the primitive items of a binary game file from memory
+///
+/// The reader works directly on a buffer holding the whole file.
+/// Every read is checked against the end of the buffer, so that a
+/// truncated or corrupted file raises an InvalidFileException instead
+/// of reading (or allocating) past the data actually present.
+class BinaryFileReader {
+private:
+  const char *m_current, *m_end;
+
+  void Require(size_t p_bytes) const
+  {
+    if (p_bytes > (size_t) (m_end - m_current)) {
+      throw InvalidFileException("Unexpected end of binary game file");
+    }
+  }
+
+public:
+  BinaryFileReader(const char *p_begin, const char *p_end)
+    : m_current(p_begin), m_end(p_end) { }
+
+  /// Checks the signature and header, and returns the kind of game stored
+  BinaryGameKind ReadHeader(void)
+  {
+    if (!IsBinaryGameFile(m_current, m_end)) {
+      throw InvalidFileException("Not a binary game file");
+    }
+    m_current += BINARY_FILE_SIGNATURE_LENGTH;
+    if (Read<uint32_t>() != BINARY_FILE_VERSION) {
+      throw InvalidFileException("Unsupported version of binary game file");
+    }
+    if (Read<uint32_t>() != BINARY_FILE_BYTE_ORDER) {
+      throw InvalidFileException("Binary game file was written with a different byte order");
+    }
+    uint32_t kind = Read<uint32_t>();
+    if (kind != BINARY_GAME_TABLE && kind != BINARY_GAME_TREE) {
+      throw InvalidFileException("Unknown kind of game in binary game file");
+    }
+    return (BinaryGameKind) kind;
+  }
+
+  /// Reads a single number
+  template <class T> T Read(void)
+  {
+    T value;
+    Require(sizeof(T));
+    memcpy(&value, m_current, sizeof(T));
+    m_current += sizeof(T);
+    return value;
+  }
+  /// Reads a contiguous block of p_count numbers into p_values
+  template <class T> void ReadArray(T *p_values, size_t p_count)
+  {
+    if (p_count == 0)  return;
+    Require(p_count * sizeof(T));
+    memcpy(p_values, m_current, p_count * sizeof(T));
+    m_current += p_count * sizeof(T);
+  }
+  /// Reads a string written with its length
+  std::string ReadString(void)
+  {
+    uint32_t length = Read<uint32_t>();
+    Require(length);
+    std::string value(m_current, length);
+    m_current += length;
+    return value;
+  }
+  /// \brief Reads a count of items, each occupying at least p_itemSize bytes
+  ///
+  /// Counts are checked against the data remaining, so that a corrupted
+  /// count is reported rather than used to size an allocation.
+  size_t ReadCount(size_t p_itemSize)
+  {
+    uint64_t count = Read<uint64_t>();
+    if (p_itemSize > 0 && count > (uint64_t) (m_end - m_current) / p_itemSize) {
+      throw InvalidFileException("Unexpected end of binary game file");
+    }
+    return (size_t) count;
+  }
+
+  /// Returns the number of bytes not yet read
+  size_t Remaining(void) const { return m_end - m_current; }
+  /// Returns true if all the data has been read
+  bool AtEnd(void) const { return m_current == m_end; }
+};
+
+}  // end namespace Gambit
+
+#endif  // LIBGAMBIT_BINFILE_H
@@ -39,16 +39,21 @@ namespace Gambit {
 /// but will instead be marked as deleted.  Calling code should always
 /// be careful to check the deleted status of the object before any
 /// operations on it.
+///
+/// Objects belonging to a frozen game (see GameRep::Freeze()) are
+/// shared: they are no longer reference counted at all, so that handles
+/// to them may be copied and released by several threads at once.
+/// Shared objects live as long as their game does.
 class GameObject {
 protected:
   int m_refCount;
-  bool m_valid;
+  bool m_valid, m_shared;
 
 public:
   /// @name Lifecycle
   //@{
   /// Constructor; initializes reference count
-  GameObject(void) : m_refCount(0), m_valid(true) { }
+  GameObject(void) : m_refCount(0), m_valid(true), m_shared(false) { }
   /// Destructor
   virtual ~GameObject() { }
   //@}
@@ -59,17 +64,23 @@ public:
   bool IsValid(void) const { return m_valid; }
   /// Invalidate the object; delete if not referenced elsewhere
   void Invalidate(void)
-  { if (!m_refCount) delete this; else m_valid = false; }
+  { if (!m_refCount || m_shared) delete this; else m_valid = false; }
   //@}
 
   /// @name Reference counting
   //@{
   /// Increment the reference count
-  void IncRef(void) { m_refCount++; }
+  void IncRef(void) { if (!m_shared) m_refCount++; }
   /// Decrement the reference count; delete if reference count is zero.
-  void DecRef(void) { if (!--m_refCount && !m_valid) delete this; }
+  void DecRef(void) 
+  { if (!m_shared && !--m_refCount && !m_valid) delete this; }
   /// Returns the reference count
   int RefCount(void) const { return m_refCount; }
+  /// Stops counting references to the object, so that handles to it
+  /// can be used from several threads
+  void Share(void) { m_shared = true; }
+  /// Is the object shared, and no longer reference counted?
+  bool IsShared(void) const { return m_shared; }
   //@}
 };
 
@@ -198,7 +209,8 @@ public:
 /// specifies a vector of payoffs to players.  Payoffs are specified
 /// using text strings, in either decimal or rational format.  All
 /// payoffs are treated as exact (that is, no conversion to floating
-/// point is done).
+/// point is done).  The payoffs themselves are held in the game's
+/// PayoffTable, indexed by the outcome's number.
 class GameOutcomeRep : public GameObject  {
   friend class GameExplicitRep;
   friend class GameTreeRep;
@@ -209,13 +221,13 @@ private:
   GameRep *m_game;
   int m_number;
   std::string m_label;
-  Array<Number> m_payoffs;
+  PayoffTable *m_payoffs;
   GameOutcome m_unrestricted;
 
   /// @name Lifecycle
   //@{
-  /// Creates a new outcome object, with payoffs set to zero
-  GameOutcomeRep(GameRep *p_game, int p_number);
+  /// Creates a new outcome object, whose payoffs are stored in p_payoffs
+  GameOutcomeRep(GameRep *p_game, PayoffTable *p_payoffs, int p_number);
   virtual ~GameOutcomeRep() { }
   //@}
 
@@ -233,14 +245,9 @@ public:
   void SetLabel(const std::string &p_label) { m_label = p_label; }
 
   /// Gets the payoff associated with the outcome to player 'pl'
-  template <class T> const T &GetPayoff(int pl) const 
-    { return (const T &) m_payoffs[pl]; }
+  template <class T> T GetPayoff(int pl) const;
   /// Sets the payoff to player 'pl'
-  void SetPayoff(int pl, const std::string &p_value)
-  {
-    m_payoffs[pl] = p_value;
-    //m_game->ClearComputedValues();
-  }
+  void SetPayoff(int pl, const std::string &p_value);
 
   /// Map the outcome to the corresponding outcome in the unrestricted game
   GameOutcome Unrestrict(void) const 
@@ -248,6 +255,24 @@ public:
   //@}
 };
 
+template<> inline double GameOutcomeRep::GetPayoff(int pl) const
+{
+  if (pl < 1 || pl > m_payoffs->NumPlayers())  throw IndexException();
+  return m_payoffs->GetDouble(m_number, pl);
+}
+
+template<> inline Rational GameOutcomeRep::GetPayoff(int pl) const
+{
+  if (pl < 1 || pl > m_payoffs->NumPlayers())  throw IndexException();
+  return m_payoffs->GetRational(m_number, pl);
+}
+
+template<> inline std::string GameOutcomeRep::GetPayoff(int pl) const
+{
+  if (pl < 1 || pl > m_payoffs->NumPlayers())  throw IndexException();
+  return m_payoffs->GetText(m_number, pl);
+}
+
 typedef GameObjectPtr<GameOutcomeRep> GameOutcome;
 
 /// An action at an information set in an extensive game
@@ -346,6 +371,7 @@ class GameStrategyRep : public GameObject  {
   template <class T> friend class MixedStrategyProfile;
   template <class T> friend class TableMixedStrategyProfileRep;
   template <class T> friend class MixedBehaviorProfile;
+  friend class PlayerSequenceTable;
 
 private:
   int m_number, m_id;
@@ -560,6 +586,9 @@ public:
   { return GetPayoff(p_player->GetNumber()); }
   /// Get the value of playing strategy against the profile
   virtual Rational GetStrategyValue(const GameStrategy &) const = 0;
+  /// Get the values of playing each of the player's strategies against
+  /// the profile, indexed by strategy number
+  virtual Array<Rational> GetStrategyValues(const GamePlayer &) const;
 
   /// Is the profile a pure strategy Nash equilibrium?
   bool IsNash(void) const;
@@ -659,8 +688,9 @@ class GameRep : public GameObject {
 
 protected:
   std::string m_title, m_comment;
+  bool m_frozen;
 
-  GameRep(void) { }
+  GameRep(void) : m_frozen(false) { }
 
   /// @name Managing the representation
   //@{
@@ -672,6 +702,10 @@ protected:
   virtual void BuildComputedValues(void) { }
   /// Have computed values been built?
   virtual bool HasComputedValues(void) const { return false; }
+  /// Builds all computed values, and shares the game and all its
+  /// objects, so that nothing is computed or counted when it is read
+  virtual void MakeShared(void) 
+  { throw UndefinedException("This game representation cannot be frozen"); }
   //@}
 
 
@@ -682,6 +716,22 @@ public:
   virtual ~GameRep() { }
   /// Create a copy of the game, as a new game
   virtual Game Copy(void) const = 0;
+  /// \brief Returns a frozen copy of the game
+  ///
+  /// A frozen game has all its computed values (strategies of tree
+  /// games, the compiled tree, payoff tables) built in advance, and
+  /// none of its objects are reference counted.  It cannot be changed,
+  /// apart from the text of labels and comments; attempts to do so
+  /// throw an UndefinedException.  Reading a frozen game changes
+  /// nothing in it, so it may be shared by any number of threads, for
+  /// instance to run several solvers at once.  Freezing a game which is
+  /// already frozen returns the game itself.
+  Game Freeze(void) const;
+  /// Returns true if the game is frozen
+  bool IsFrozen(void) const { return m_frozen; }
+  /// Throws an UndefinedException if the game is frozen
+  void CheckMutable(void) const
+  { if (m_frozen) throw UndefinedException("A frozen game cannot be changed"); }
   //@}
 
   /// @name General data access
@@ -743,7 +793,7 @@ public:
   /// Gets the i'th strategy in the game, numbered globally
   virtual GameStrategy GetStrategy(int p_index) const = 0;
   /// Returns the number of strategy contingencies in the game
-  virtual int NumStrategyContingencies(void) const = 0;
+  virtual long NumStrategyContingencies(void) const = 0;
   /// Returns the total number of actions in the game
   virtual int BehavProfileLength(void) const = 0;
   /// Returns the total number of strategies in the game
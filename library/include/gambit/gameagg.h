@@ -70,7 +70,7 @@ public:
   /// Returns the total number of strategies in the game
   virtual int MixedProfileLength(void) const 
   { return aggPtr->getNumActions(); }
-  virtual int NumStrategyContingencies(void) const
+  virtual long NumStrategyContingencies(void) const
   { throw UndefinedException(); }
   //@}
 
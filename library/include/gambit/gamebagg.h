@@ -63,7 +63,7 @@ public:
   virtual GameStrategy GetStrategy(int p_index) const
   { throw UndefinedException(); }
   /// Returns the number of strategy contingencies in the game
-  virtual int NumStrategyContingencies(void) const
+  virtual long NumStrategyContingencies(void) const
   { throw UndefinedException(); }
   /// Returns the total number of actions in the game
   virtual int BehavProfileLength(void) const
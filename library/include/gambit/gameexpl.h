@@ -32,6 +32,13 @@ class GameExplicitRep : public GameRep {
 protected:
   Array<GamePlayerRep *> m_players;
   Array<GameOutcomeRep *> m_outcomes;
+  /// Payoffs of all outcomes, indexed by outcome number
+  PayoffTable m_payoffs;
+
+  /// @name Managing the representation
+  //@{
+  virtual void MakeShared(void);
+  //@}
 
   /// @name Writing data files
   //@{
@@ -41,6 +48,9 @@ protected:
   /// Write the game in .nfg format to the specified stream
   virtual void WriteNfgFile(std::ostream &) const
   { throw UndefinedException(); }
+  /// Write the game in binary format to the specified stream
+  virtual void WriteBinaryFile(std::ostream &) const
+  { throw UndefinedException(); }
   //@}
 
 public:
@@ -65,7 +75,7 @@ public:
   /// Gets the i'th strategy in the game, numbered globally
   virtual GameStrategy GetStrategy(int p_index) const;
   /// Returns the number of strategy contingencies in the game
-  virtual int NumStrategyContingencies(void) const;
+  virtual long NumStrategyContingencies(void) const;
   /// Returns the total number of strategies in the game
   virtual int MixedProfileLength(void) const;
   //@}
@@ -35,21 +35,40 @@ class GameTableRep : public GameExplicitRep {
   template <class T> friend class MixedStrategyProfile;
   template <class T> friend class TableMixedStrategyProfileRep;
 private:
-  Array<GameOutcomeRep *> m_results;
+  /// The outcome of each contingency, stored at its index less one
+  std::vector<GameOutcomeRep *> m_results;
   Game m_unrestricted;
 
+  /// @name Payoff tensor cache
+  //@{
+  /// Payoffs to each player, laid out contiguously by contingency index
+  mutable std::vector<std::vector<double> > m_doubleTensor;
+  mutable std::vector<std::vector<Rational> > m_rationalTensor;
+  /// Whether the tensors are built, and the payoff revision they reflect
+  mutable bool m_doubleTensorValid, m_rationalTensorValid;
+  mutable unsigned long m_doubleRevision, m_rationalRevision;
+  //@}
+
   /// @name Private auxiliary functions
   //@{
   void IndexStrategies(void);
   void RebuildTable(void);
   //@}
 
+  /// @name Managing the representation
+  //@{
+  virtual void ClearComputedValues(void) const;
+  virtual void MakeShared(void);
+  //@}
+
 public:
   /// @name Lifecycle
   //@{
   /// Construct a new table game with the given dimension
   /// If p_sparseOutcomes = true, outcomes for all contingencies are left null
   GameTableRep(const Array<int> &p_dim, bool p_sparseOutcomes = false);
+  /// Create a game from a file in binary format, after its header
+  static Game ReadBinaryFile(BinaryFileReader &);
   virtual Game Copy(void) const;
   //@}
 
@@ -120,6 +139,21 @@ public:
   //@{
   /// Write the game to a file in .nfg outcome format
   virtual void WriteNfgFile(std::ostream &) const;
+  /// Write the game to a file in binary format
+  virtual void WriteBinaryFile(std::ostream &) const;
+  //@}
+
+  /// @name Payoff tensor
+  //@{
+  /// \brief Returns the payoffs to player pl in all contingencies.
+  ///
+  /// The payoffs are laid out contiguously, with the payoff of the
+  /// contingency in which each player plays strategy s found at the
+  /// sum of s->m_offset over the players.  Contingencies with no outcome
+  /// have payoff zero.  The tensor is built on first use, and rebuilt
+  /// after the game or any of its payoffs are changed; the pointer
+  /// returned is only valid until then.
+  template <class T> const T *GetPayoffTensor(int pl) const;
   //@}
 
   virtual PureStrategyProfile NewPureStrategyProfile(void) const;
@@ -130,6 +164,9 @@ public:
 
 };
 
+template<> const double *GameTableRep::GetPayoffTensor(int pl) const;
+template<> const Rational *GameTableRep::GetPayoffTensor(int pl) const;
+
 }
 
 
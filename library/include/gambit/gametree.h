@@ -196,6 +196,141 @@ public:
 };
 
 
+/// \brief A flattened, read-only copy of the structure of a game tree
+///
+/// The nodes are listed in preorder, and each node is identified by its
+/// position in that list.  For each node, the compiled tree records
+/// the positions of its parent and children, the information set at
+/// which it is a decision node, the action leading to it, and its
+/// outcome.  Information sets are numbered consecutively over the
+/// personal players, in the layout of a PVector shaped by
+/// GameRep::NumInfosets(), followed by those of the chance player.
+/// Actions are numbered consecutively over the information sets in
+/// the same order, so that the number of an action of a personal
+/// player is its index in a DVector shaped by GameRep::NumActions().
+///
+/// Computations which traverse the whole tree, such as the evaluation
+/// of behavior profiles, can then be written as loops over arrays,
+/// instead of following handles through the node objects.  The
+/// compiled tree is built on demand by GameTreeRep::GetCompiledTree(),
+/// and is discarded whenever the structure of the game changes; the
+/// payoffs of the outcomes are not copied, and are read from the
+/// outcomes when needed.
+class CompiledGameTree {
+  friend class GameTreeRep;
+private:
+  int m_numPlayers;
+
+  /// @name Nodes, by position in preorder
+  //@{
+  Array<int> m_nodeNumber, m_parent, m_infoset, m_priorAction;
+  Array<GameOutcomeRep *> m_outcome;
+  /// The children of node i are at m_children[m_childStart[i]] onwards
+  Array<int> m_childStart, m_numChildren, m_children;
+  /// The positions of the nodes, listed in postorder
+  Array<int> m_postorder;
+  /// The subtree rooted at node i occupies positions i to m_subtreeEnd[i]
+  Array<int> m_subtreeEnd;
+  /// Whether each node is the root of a proper subgame
+  Array<bool> m_subgameRoot;
+  //@}
+
+  /// @name Information sets
+  //@{
+  /// The number preceding the first information set of each player
+  /// (indexed from zero, for the chance player)
+  Array<int> m_infosetOffset;
+  Array<GameTreeInfosetRep *> m_infosets;
+  /// The actions of infoset f are numbered m_firstAction[f] onwards
+  Array<int> m_infosetPlayer, m_firstAction;
+  /// The members of infoset f are at m_members[m_memberStart[f]] onwards
+  Array<int> m_memberStart, m_members;
+  //@}
+
+  /// @name Perfect recall
+  //@{
+  /// Whether each personal player has perfect recall
+  Array<bool> m_perfectRecall;
+  /// The pairs of information sets violating perfect recall, in order
+  std::vector<std::pair<int, int> > m_recallViolations;
+  //@}
+
+  CompiledGameTree(int p_numPlayers)
+    : m_numPlayers(p_numPlayers), m_infosetOffset(0, p_numPlayers) { }
+
+public:
+  /// @name Dimensions
+  //@{
+  int NumPlayers(void) const { return m_numPlayers; }
+  int NumNodes(void) const { return m_nodeNumber.Length(); }
+  /// Returns the number of information sets, including those of chance
+  int NumInfosets(void) const { return m_infosets.Length(); }
+  /// Returns the number of information sets of the personal players
+  int NumPersonalInfosets(void) const { return m_infosetOffset[0]; }
+  /// Returns the number of actions, including those of chance
+  int NumActions(void) const { return m_firstAction[NumInfosets() + 1] - 1; }
+  //@}
+
+  /// @name Nodes
+  //@{
+  /// Returns the number of the node (as in GameNodeRep::GetNumber())
+  int GetNodeNumber(int p_node) const { return m_nodeNumber[p_node]; }
+  /// Returns the position of the parent of the node, or zero at the root
+  int GetParent(int p_node) const { return m_parent[p_node]; }
+  /// Returns the information set of the node, or zero if it is terminal
+  int GetInfoset(int p_node) const { return m_infoset[p_node]; }
+  /// Returns the action leading to the node, or zero at the root
+  int GetPriorAction(int p_node) const { return m_priorAction[p_node]; }
+  /// Returns the outcome attached to the node, or null if none
+  GameOutcomeRep *GetOutcome(int p_node) const { return m_outcome[p_node]; }
+  int NumChildren(int p_node) const { return m_numChildren[p_node]; }
+  /// Returns the position of the p_index'th child of the node
+  int GetChild(int p_node, int p_index) const
+  { return m_children[m_childStart[p_node] + p_index - 1]; }
+  /// Returns the position of the p_index'th node in postorder
+  int GetPostorder(int p_index) const { return m_postorder[p_index]; }
+  /// Returns the position of the last node in the subtree rooted at the node
+  int GetSubtreeEnd(int p_node) const { return m_subtreeEnd[p_node]; }
+  /// Returns true if the node is the root of a (proper) subgame
+  bool IsSubgameRoot(int p_node) const { return m_subgameRoot[p_node]; }
+  //@}
+
+  /// @name Information sets and actions
+  //@{
+  /// Returns the number of the information set p_iset of player p_player
+  /// (with zero denoting the chance player)
+  int GetInfosetIndex(int p_player, int p_iset) const
+  { return m_infosetOffset[p_player] + p_iset; }
+  GameTreeInfosetRep *GetInfosetRep(int p_infoset) const
+  { return m_infosets[p_infoset]; }
+  /// Returns the player at the information set, or zero for chance
+  int GetInfosetPlayer(int p_infoset) const { return m_infosetPlayer[p_infoset]; }
+  /// Returns the number of the first action at the information set
+  int GetFirstAction(int p_infoset) const { return m_firstAction[p_infoset]; }
+  int NumActions(int p_infoset) const
+  { return m_firstAction[p_infoset + 1] - m_firstAction[p_infoset]; }
+  int NumMembers(int p_infoset) const
+  { return m_memberStart[p_infoset + 1] - m_memberStart[p_infoset]; }
+  /// Returns the position of the p_index'th member of the information set
+  int GetMember(int p_infoset, int p_index) const
+  { return m_members[m_memberStart[p_infoset] + p_index - 1]; }
+  //@}
+
+  /// @name Perfect recall
+  //@{
+  /// Returns true if the members of each information set of the player
+  /// are reached by the same sequence of the player's own actions
+  bool IsPerfectRecall(int p_player) const { return m_perfectRecall[p_player]; }
+  int NumRecallViolations(void) const { return m_recallViolations.size(); }
+  /// Returns the p_index'th violation of perfect recall.  The second
+  /// information set has members reached by different sequences of the
+  /// player's actions, and one of these sequences ends with an action at
+  /// the first (which is the second itself if the player is absent-minded).
+  const std::pair<int, int> &GetRecallViolation(int p_index) const
+  { return m_recallViolations[p_index - 1]; }
+  //@}
+};
+
 class GameTreeRep : public GameExplicitRep {
   friend class GameTreeNodeRep;
   friend class GameTreeInfosetRep;
@@ -204,10 +339,40 @@ protected:
   mutable bool m_computedValues, m_doCanon;
   GameTreeNodeRep *m_root;
   GamePlayerRep *m_chance;
+  mutable CompiledGameTree *m_compiled;
 
   /// @name Private auxiliary functions
   //@{
   void NumberNodes(GameTreeNodeRep *, int &);
+  /// Adds the subtree rooted at p_node to the compiled tree, returning
+  /// the position of p_node
+  int CompileNode(CompiledGameTree &, GameTreeNodeRep *p_node, int p_parent,
+		  std::vector<std::vector<int> > &p_members) const;
+  //@}
+
+  /// @name Copying games
+  //@{
+  /// Creates a new game with the same title, comment, and players
+  GameTreeRep *CopyPlayers(void) const;
+  /// Creates a copy of an information set from another game,
+  /// belonging to the corresponding player in this game
+  GameTreeInfosetRep *CopyInfoset(const GameTreeInfosetRep *);
+  /// \brief Copies a subtree of another game into this game
+  ///
+  /// Copies the subtree rooted at p_src to the (terminal) node p_dest.
+  /// Information sets and outcomes are looked up by their numbers in the
+  /// source game in p_infosets (indexed by player, chance first) and
+  /// p_outcomes; any not yet present are created when first reached.
+  void CopySubtree(const GameTreeNodeRep *p_src, GameTreeNodeRep *p_dest,
+		   std::vector<std::vector<GameTreeInfosetRep *> > &p_infosets,
+		   std::vector<GameOutcomeRep *> &p_outcomes);
+  //@}
+
+  /// @name Binary files
+  //@{
+  /// Reads the subtree rooted at the (terminal) node p_node from a
+  /// binary file, after the information sets have been read
+  void ReadBinaryNode(BinaryFileReader &, GameTreeNodeRep *p_node);
   //@}
 
   /// @name Managing the representation
@@ -217,6 +382,7 @@ protected:
   virtual void ClearComputedValues(void) const;
   /// Have computed values been built?
   virtual bool HasComputedValues(void) const { return m_computedValues; }
+  virtual void MakeShared(void);
   //@}
 
 public: 
@@ -224,6 +390,8 @@ public:
   //@{
   GameTreeRep(void);
   virtual ~GameTreeRep();
+  /// Create a game from a file in binary format, after its header
+  static Game ReadBinaryFile(BinaryFileReader &);
   virtual Game Copy(void) const;
   //@}
 
@@ -233,10 +401,17 @@ public:
   virtual bool IsConstSum(void) const;
   using GameRep::IsPerfectRecall;
   virtual bool IsPerfectRecall(GameInfoset &, GameInfoset &) const;
+  /// Returns all the violations of perfect recall, as pairs of
+  /// information sets (see CompiledGameTree::GetRecallViolation())
+  List<std::pair<GameInfoset, GameInfoset> > GetRecallViolations(void) const;
+  /// Returns the flattened structure of the tree, building it if needed
+  const CompiledGameTree &GetCompiledTree(void) const;
   /// Turn on or off automatic canonicalization of the game
   void SetCanonicalization(bool p_doCanon) const
   { m_doCanon = p_doCanon;
     if (m_doCanon) const_cast<GameTreeRep *>(this)->Canonicalize(); }
+  /// Is the game canonicalized automatically after each change?
+  bool GetCanonicalization(void) const { return m_doCanon; }
   //@}
 
   /// @name Players
@@ -262,6 +437,7 @@ public:
   virtual void WriteEfgFile(std::ostream &) const;
   virtual void WriteEfgFile(std::ostream &, const GameNode &p_node) const;
   virtual void WriteNfgFile(std::ostream &) const;
+  virtual void WriteBinaryFile(std::ostream &) const;
   //@}
 
   /// @name Dimensions of the game
@@ -292,6 +468,116 @@ public:
 
 };
 
+/// \brief Defers the canonicalization of a tree over a block of edits
+///
+/// Ordinarily, each change to the structure of a tree renumbers its
+/// nodes and information sets.  While an object of this class exists,
+/// this is put off, and is done once when the object is destroyed, so
+/// that building a large tree does not take time quadratic in its size.
+/// In between, the numbers of nodes and information sets, and anything
+/// computed from them (such as strategies and profiles), are not
+/// meaningful.  Scopes may be nested, in which case only the outermost
+/// canonicalizes.
+class DeferredCanonicalization {
+private:
+  Game m_game;
+  bool m_previous;
+
+  DeferredCanonicalization(const DeferredCanonicalization &);
+  DeferredCanonicalization &operator=(const DeferredCanonicalization &);
+
+public:
+  /// Defers canonicalization of the game, which must be a tree
+  DeferredCanonicalization(const Game &p_game);
+  /// Restores the previous setting, canonicalizing if it was on
+  ~DeferredCanonicalization();
+};
+
+/// \brief The reduced strategies of a player in a tree game
+///
+/// Materializing the reduced strategies of a tree game (as is done for
+/// GamePlayerRep::Strategies()) takes time and memory exponential in the
+/// number of information sets.  This class instead describes the
+/// reduced strategies of a player implicitly.  The strategies can be
+/// counted, the strategy with a given index can be found (and the
+/// index of a given strategy), and the strategies can be visited in
+/// turn, without ever storing them all.  Strategies are numbered in the
+/// order in which GamePlayerRep::Strategies() lists them, and are
+/// represented as in GameStrategyRep, by the number of the action taken
+/// at each information set, or zero at information sets the strategy
+/// does not reach.
+///
+/// Counting relies on the player having perfect recall, so that the
+/// choices at information sets which follow different actions of the
+/// player are independent.  The space describes the game as it was
+/// when constructed, and must be rebuilt if the game changes.
+class ReducedStrategySpace {
+private:
+  int m_player, m_numInfosets;
+  /// @name The tree, by position in preorder
+  //@{
+  /// The player's information set at each node, or zero at other nodes
+  Array<int> m_infoset;
+  /// The children of node i are at m_children[m_childStart[i]] onwards
+  Array<int> m_childStart, m_numChildren, m_children;
+  //@}
+  /// @name Counts of strategies
+  //@{
+  /// The sequences ending at each information set are numbered
+  /// from m_firstSequence[i], one for each action
+  Array<int> m_firstSequence;
+  /// For each sequence of the player's actions, the number of ways to
+  /// choose at the information sets which immediately follow it
+  /// (sequence 0 is empty, and this is the number of strategies)
+  Array<Integer> m_following;
+  /// For each information set, the number of ways to choose there and
+  /// at the information sets which follow it
+  Array<Integer> m_choices;
+  //@}
+
+  /// Finds the strategy numbered p_index, or the index of p_behav,
+  /// walking the tree in the order in which strategies are numbered
+  void Walk(Integer &p_index, Array<int> &p_behav, bool p_find) const;
+
+public:
+  /// Builds the space of reduced strategies of the player; throws an
+  /// UndefinedException if the player does not have perfect recall
+  ReducedStrategySpace(const GamePlayer &p_player);
+
+  int GetPlayer(void) const { return m_player; }
+  /// Returns the number of reduced strategies of the player
+  const Integer &NumStrategies(void) const { return m_following[0]; }
+  /// Returns the actions taken by the p_index'th reduced strategy
+  Array<int> GetStrategy(const Integer &p_index) const;
+  /// Returns the index of the reduced strategy taking the given actions
+  /// (actions at information sets it does not reach are ignored)
+  Integer GetIndex(const Array<int> &p_behav) const;
+
+  /// Visits the reduced strategies of a player in order
+  class iterator {
+  private:
+    const ReducedStrategySpace &m_space;
+    Integer m_index;
+    Array<int> m_behav;
+
+  public:
+    iterator(const ReducedStrategySpace &p_space)
+      : m_space(p_space), m_index(1)
+    { if (!AtEnd())  m_behav = m_space.GetStrategy(m_index); }
+
+    void operator++(void)
+    { ++m_index;  if (!AtEnd())  m_behav = m_space.GetStrategy(m_index); }
+    bool AtEnd(void) const { return m_index > m_space.NumStrategies(); }
+
+    /// Returns the index of the current strategy
+    const Integer &GetIndex(void) const { return m_index; }
+    /// Returns the actions taken by the current strategy
+    const Array<int> &operator*(void) const { return m_behav; }
+  };
+
+  iterator begin(void) const { return iterator(*this); }
+};
+
 }
 
 
@@ -82,10 +82,32 @@ extern int      Iislong(const IntegerRep*);
 extern int      Iisdouble(const IntegerRep*);
 extern long     lg(const IntegerRep*);
 
+struct IntegerLongRep;
+
+/// \brief An arbitrary-length integer
+///
+/// Values which fit in a machine word (other than the most negative
+/// long) are held inline in m_small, with rep null, and arithmetic on
+/// them is done directly in machine words, checking for overflow.
+/// Only values outside that range are held in an IntegerRep, so that
+/// each value has exactly one representation.
 class Integer {
 protected:
+  long m_small;
   IntegerRep *rep;
 
+  /// @name Representation
+  //@{
+  /// Returns the value as an IntegerRep, using the buffer if held inline
+  const IntegerRep *GetRep(IntegerLongRep &) const;
+  /// Sets the value from the result of an operation on IntegerReps
+  void SetRep(IntegerRep *);
+  /// Sets the value to a long
+  void SetSmall(long);
+  /// Changes a value held inline to be held in an IntegerRep
+  void Expand(void);
+  //@}
+
 public:
   /// @name Lifecycle
   //@{
@@ -218,11 +240,12 @@ public:
 
   // coercion & conversion
 
-  int             fits_in_long() const { return Iislong(rep); }
-  int             fits_in_double() const { return Iisdouble(rep); }
+  int             fits_in_long() const { return (rep) ? Iislong(rep) : 1; }
+  int             fits_in_double() const { return (rep) ? Iisdouble(rep) : 1; }
 
-  long		  as_long() const { return Itolong(rep); }
-  double	  as_double() const { return Itodouble(rep); }
+  long		  as_long() const { return (rep) ? Itolong(rep) : m_small; }
+  double	  as_double() const 
+  { return (rep) ? Itodouble(rep) : (double) m_small; }
 
   friend std::string Itoa(const Integer &x, int base /*= 10*/, int width /*= 0*/);
   friend Integer atoI(const char *s, int base/*= 10*/);
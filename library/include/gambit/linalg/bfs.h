@@ -54,6 +54,16 @@ public:
   }
   bool operator!=(const BFS &M) const  { return !(*this == M); }
 
+  // hash the basis, so that BFS's which are equal hash alike
+  size_t BasisHash(void) const {
+    size_t hash = m_map.size();
+    for (typename std::map<int, T>::const_iterator iter = m_map.begin();
+	 iter != m_map.end(); iter++) {
+      hash ^= (size_t) (*iter).first + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+  }
+
   // Provide map-like operations
   int count(int key) const { return (m_map.count(key) > 0); }
 
@@ -72,6 +82,14 @@ public:
   }
 };
 
+//
+// Hash function object, to keep BFS's in unordered containers
+//
+template <class T> class BFSHash {
+public:
+  size_t operator()(const BFS<T> &p_bfs) const { return p_bfs.BasisHash(); }
+};
+
 }  // end namespace Gambit::linalg
 
 }  // end namespace Gambit
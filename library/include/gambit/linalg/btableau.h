@@ -106,6 +106,8 @@ public:
   Basis & GetBasis(void);
   const Matrix<T> & Get_A(void) const;
   const Vector<T> & Get_b(void) const;
+  // use a matrix of the same shape; the tableau must be refactored after
+  void Set_A(const Matrix<T> &);
   
   bool Member(int i) const;
   int Label(int i) const;   // return variable in i'th position of Tableau
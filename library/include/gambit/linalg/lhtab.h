@@ -65,6 +65,8 @@ public:
   /// @name Raw Tableau functions
   //@{
   void Refactor(void) { T1.Refactor(); T2.Refactor(); }
+  /// Makes the tableau independent of the one it was copied from
+  void Detach(void) { T1.Detach(); T2.Detach(); }
   //@}
   
   /// @name Miscellaneous functions
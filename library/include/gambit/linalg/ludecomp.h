@@ -121,6 +121,12 @@ public:
 
   // refactor 
   void refactor();
+
+  // copies the factorization held by the decompositions this one was
+  // copied from, so that it no longer refers to them.  The
+  // decomposition then solves systems exactly as before, and can be
+  // used while the others are changed, or from another thread.
+  void detach();
   
   // solve: Bk d = a
   void solve (const Vector<T> &, Vector<T> & ) const;
@@ -63,6 +63,8 @@ public:
 
   void Refactor();
   void SetRefactor(int);
+  /// Makes the tableau independent of the one it was copied from
+  void Detach() { B.detach(); }
 
   void SetConst(const Vector<double> &bnew);
   void SetBasis( const Basis &); // set new Tableau
@@ -121,6 +123,8 @@ public:
 
   void Refactor();
   void SetRefactor(int);
+  /// Makes the tableau independent of the one it was copied from
+  void Detach() { }
 
   void SetConst(const Vector<Rational> &bnew);
   void SetBasis( const Basis &); // set new Tableau
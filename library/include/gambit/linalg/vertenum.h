@@ -23,6 +23,8 @@
 #ifndef GAMBIT_LINALG_VERTENUM_H
 #define GAMBIT_LINALG_VERTENUM_H
 
+#include <atomic>
+#include <vector>
 #include "gambit/gambit.h"
 #include "gambit/linalg/lptab.h"
 #include "gambit/linalg/bfs.h"
@@ -42,6 +44,13 @@ namespace linalg {
 // The code is based on the reverse Pivoting algorithm of Avis 
 // and Fukuda, Discrete Computational Geom (1992) 8:295-313.
 //
+// The subtrees of the reverse search are independent.  If more than
+// one thread is requested, the search tree is expanded down to the
+// given depth, and the subtrees below it are handed out to the
+// threads, each of which searches with its own copy of the tableau.
+// The vertices are listed in the same order as by a search in one
+// thread, whatever the number of threads.
+//
 template <class T> class VertexEnumerator {
 private:
   int mult_opt,depth;
@@ -55,6 +64,14 @@ private:
   Gambit::List<Vector<T> > Verts;
   long npivots, nodes;
   Gambit::List<long> visits,branches;
+  int m_numThreads, m_splitDepth;
+
+  /// A subtree of the search, which is searched by one thread
+  class Subtree;
+
+  /// Creates an enumerator to search below the current depth of the
+  /// search of p_parent, in one thread
+  VertexEnumerator(const VertexEnumerator<T> &p_parent, int p_depth);
 
   void Enum(void);
   void Deeper(void);
@@ -62,8 +79,27 @@ private:
   void Search(LPTableau<T> &tab);
   void DualSearch(LPTableau<T> &tab);
 
+  /// @name Searching in several threads
+  //@{
+  /// Searches the tree rooted at the tableau, handing out the subtrees
+  /// p_levels below to the threads
+  void ParallelSearch(LPTableau<T> &tab);
+  /// Expands the tree p_levels down from the tableau, listing the
+  /// vertices found and the subtrees left to search in order
+  void Split(LPTableau<T> &tab, int p_levels, std::vector<Subtree *> &);
+  /// Searches the subtrees not yet taken by another thread
+  static void SearchSubtrees(std::vector<Subtree *> *,
+			     std::atomic<int> *p_next);
+  /// Appends the vertices found by the search of a subtree
+  void Merge(const VertexEnumerator<T> &);
+  //@}
+
 public:
-  VertexEnumerator(const Matrix<T> &, const Vector<T> &);
+  /// Enumerates the vertices of the polyhedron, searching in
+  /// p_numThreads threads, with subtrees p_splitDepth levels below
+  /// the root handed out to the threads
+  VertexEnumerator(const Matrix<T> &, const Vector<T> &,
+		   int p_numThreads = 1, int p_splitDepth = 3);
   VertexEnumerator(LPTableau<T> &);
   ~VertexEnumerator() { }
   
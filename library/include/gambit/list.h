@@ -3,7 +3,7 @@
 // Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
 //
 // FILE: src/libgambit/list.h
-// A generic (doubly) linked-list container class
+// A generic list container class
 //
 // This program is free software; you can redistribute it and/or modify
 // it under the terms of the GNU General Public License as published by
@@ -23,99 +23,83 @@
 #ifndef LIBGAMBIT_LIST_H
 #define LIBGAMBIT_LIST_H
 
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
 namespace Gambit {
 
-/// A doubly-linked list container.
+/// A list container.
 ///
-/// This implements a doubly-linked list.  A special feature of this
-/// class is that it caches the last item accessed by indexing via
-/// operator[], meaning that, if accesses are done in sequential order,
-/// indexing time is constant.
+/// This implements a list, indexed starting at one, whose elements are
+/// stored contiguously in a std::vector.  Indexing via operator[]
+/// therefore takes constant time in any order of access, and iterating
+/// through the list visits consecutive memory.  Appending an element
+/// takes amortized constant time; inserting or removing an element
+/// elsewhere moves the elements which follow it.  Unlike Array, the
+/// element type need not have a default constructor or an assignment
+/// operator, as long as it can be copied; however, since
+/// std::vector<bool> does not store its elements as bools, a List of
+/// bools cannot be indexed, and Array<bool> should be used instead.
 ///
-/// This index-cacheing feature was implemented very early in the development
-/// of Gambit, before STL-like concepts of iterators had been fully
-/// developed.  An iterator approach is a better and more robust solution
-/// to iterating lists, both in terms of performance and encapsulation.
-/// Therefore, it is recommended to avoid operator[] and use the provided
-/// iterator classes in new code, and to upgrade existing code to the
-/// iterator idiom as practical.
+/// Earlier versions of this class were implemented as a doubly-linked
+/// list, which cached the last item accessed via operator[] so that
+/// sequential access took constant time.  As with any vector-like
+/// container, references to elements are invalidated by inserting
+/// elements, so code should not hold a reference into a list across
+/// an Append() or Insert().
 template <class T> class List {
 protected:
-  class Node {
-  public:
-    T m_data;
-    Node *m_prev, *m_next;
-    
-    // CONSTRUCTOR
-    Node(const T &p_data, Node *p_prev, Node *p_next);
-  };
-
-  int m_length;
-  Node *m_head, *m_tail;
-
-  int m_currentIndex;
-  Node *m_currentNode;
-
-  int InsertAt(const T &t, int where);
+  std::vector<T> m_items;
+
+  /// Checks that the element at (one-based) index n exists
+  void CheckIndex(int n) const
+  {
+#ifdef GAMBIT_INDEX_ASSERTIONS
+    assert(n >= 1 && n <= Length());
+#else
+    if (n < 1 || n > Length())  throw IndexException();
+#endif  // GAMBIT_INDEX_ASSERTIONS
+  }
 
 public:
-  class iterator {
-  private:
-    const List &m_list;
-    Node *m_node;
-  public:
-    iterator(const List &p_list, Node *p_node)
-      : m_list(p_list), m_node(p_node)  { }
-    T &operator*(void) const { return *m_node; }
-    iterator &operator++(void)  { m_node = m_node->m_next; return *this; }
-    bool operator==(const iterator &it) const
-    { return (m_node == it.m_node); }
-    bool operator!=(const iterator &it) const
-    { return (m_node != it.m_node); }
-  };
+  typedef typename std::vector<T>::iterator iterator;
+  typedef typename std::vector<T>::const_iterator const_iterator;
+
+  List(void) { }
+  virtual ~List() { }
+
+  List<T> &operator=(const List<T> &b)
+  {
+    // Copying and swapping does not require T to be assignable
+    if (this != &b) {
+      std::vector<T> items(b.m_items);
+      m_items.swap(items);
+    }
+    return *this;
+  }
 
-  class const_iterator {
-  private:
-    const List &m_list;
-    Node *m_node;
-  public:
-    const_iterator(const List &p_list, Node *p_node)
-      : m_list(p_list), m_node(p_node)  { }
-    const T &operator*(void) const { return *m_node; }
-    const_iterator &operator++(void)  { m_node = m_node->m_next; return *this; }
-    bool operator==(const const_iterator &it) const
-    { return (m_node == it.m_node); }
-    bool operator!=(const const_iterator &it) const
-    { return (m_node != it.m_node); }
-  };
+  bool operator==(const List<T> &b) const { return m_items == b.m_items; }
+  bool operator!=(const List<T> &b) const { return m_items != b.m_items; }
 
-  List(void);
-  List(const List<T> &);
-  virtual ~List();
-  
-  List<T> &operator=(const List<T> &);
-  
-  bool operator==(const List<T> &b) const;
-  bool operator!=(const List<T> &b) const;
-  
-  iterator begin(void)             { return iterator(*this, m_head); }
-  const_iterator begin(void) const { return const_iterator(*this, m_head); }
-  iterator end(void)               { return iterator(*this, 0); }
-  const_iterator end(void) const   { return const_iterator(*this, 0); }
+  iterator begin(void)             { return m_items.begin(); }
+  const_iterator begin(void) const { return m_items.begin(); }
+  iterator end(void)               { return m_items.end(); }
+  const_iterator end(void) const   { return m_items.end(); }
 
-  const T &operator[](int) const;
-  T &operator[](int);
+  const T &operator[](int n) const  { CheckIndex(n); return m_items[n-1]; }
+  T &operator[](int n)              { CheckIndex(n); return m_items[n-1]; }
 
-  List<T> operator+(const List<T>& b) const;
-  List<T>& operator+=(const List<T>& b);
+  List<T> operator+(const List<T> &b) const;
+  List<T> &operator+=(const List<T> &b);
 
-  virtual int Append(const T &);
+  virtual int Append(const T &t)  { m_items.push_back(t); return Length(); }
   int Insert(const T &, int);
   virtual T Remove(int);
 
   int Find(const T &) const;
-  bool Contains(const T &t) const;
-  int Length(void) const { return m_length; }
+  bool Contains(const T &t) const { return (Find(t) != 0); }
+  int Length(void) const          { return m_items.size(); }
 
   /// @name STL-style interface
   ///
@@ -125,291 +109,106 @@ public:
   /// possible.
   ///@{
   /// Return whether the list container is empty (has size 0).
-  bool empty(void) const { return (m_length == 0); }
+  bool empty(void) const { return m_items.empty(); }
   /// Return the number of elements in the list container.
-  size_t size(void) const { return m_length; }
+  size_t size(void) const { return m_items.size(); }
+  /// Allocate space for at least n elements, without changing the contents.
+  void reserve(size_t n) { m_items.reserve(n); }
   /// Adds a new element at the end of the list container, after its
   /// current last element.
-  void push_back(const T &val);
+  void push_back(const T &val) { m_items.push_back(val); }
   /// Removes all elements from the list container (which are destroyed),
   /// leaving the container with a size of 0.
-  void clear(void);
-  /// Returns a reference to the first elemnet in the list container.
-  T &front(void)             { return m_head->m_data; }
+  void clear(void) { m_items.clear(); }
+  /// Returns a reference to the first element in the list container.
+  T &front(void)             { return m_items.front(); }
   /// Returns a reference to the first element in the list container.
-  const T &front(void) const { return m_head->m_data; }
+  const T &front(void) const { return m_items.front(); }
   /// Returns a reference to the last element in the list container.
-  T &back(void)             { return m_tail->m_data; }
+  T &back(void)             { return m_items.back(); }
   /// Returns a reference to the last element in the list container.
-  const T &back(void) const { return m_tail->m_data; }
+  const T &back(void) const { return m_items.back(); }
   ///@}
 };
 
-
-//--------------------------------------------------------------------------
-//                 Node: Member function implementations
-//--------------------------------------------------------------------------
-
-template <class T> 
-List<T>::Node::Node(const T &p_data,
-		    typename List<T>::Node *p_prev, typename List<T>::Node *p_next)
-  : m_data(p_data), m_prev(p_prev), m_next(p_next)
-{ }
-
 //--------------------------------------------------------------------------
 //                 List<T>: Member function implementations
 //--------------------------------------------------------------------------
 
-template <class T> List<T>::List(void) 
-  : m_length(0), m_head(0), m_tail(0), m_currentIndex(0), m_currentNode(0)
-{ }
-
-template <class T> List<T>::List(const List<T> &b)
-  : m_length(b.m_length)
-{
-  if (m_length)  {  
-    Node *n = b.m_head;
-    m_head = new Node(n->m_data, 0, 0);
-    n = n->m_next;
-    m_tail = m_head;
-    while (n)  { 
-      m_tail->m_next = new Node(n->m_data, m_tail, 0);
-      n = n->m_next;
-      m_tail = m_tail->m_next;
-    }
-    m_currentIndex = 1;
-    m_currentNode = m_head;
-  }
-  else  {
-    m_head = m_tail = 0;
-    m_currentIndex = 0;
-    m_currentNode = 0;
-  }
-}
-
-template <class T> List<T>::~List()
-{
-  Node *n = m_head;
-  while (n)  {
-    Node *m_next = n->m_next;
-    delete n;
-    n = m_next;
-  }
-}
-
-template <class T> int List<T>::InsertAt(const T &t, int num)
-{
-  if (num < 1 || num > m_length + 1)   throw IndexException();
-  
-  if (!m_length)  {
-    m_head = m_tail = new Node(t, 0, 0);
-    m_length = 1;
-    m_currentIndex = 1;
-    m_currentNode = m_head;
-    return m_length;
-  }
-
-  Node *n;
-  int i;
-  
-  if( num <= 1 )  {
-    n = new Node(t, 0, m_head);
-    m_head->m_prev = n;
-    m_currentNode = m_head = n;
-    m_currentIndex = 1;
-  }
-  else if( num >= m_length + 1)  {
-    n = new Node(t, m_tail, 0);
-    m_tail->m_next = n;
-    m_currentNode = m_tail = n;
-    m_currentIndex = m_length + 1;
-  }
-  else  {
-    if( num < m_currentIndex )
-      for (i = m_currentIndex, n = m_currentNode; i > num; i--, n = n->m_prev);
-    else
-      for (i = m_currentIndex, n = m_currentNode; i < num; i++, n = n->m_next);
-    n = new Node(t, n->m_prev, n);
-    m_currentNode = n->m_prev->m_next = n->m_next->m_prev = n;
-    m_currentIndex = num;
-  }
-
-  m_length++;
-  return num;
-}
-
-//--------------------- visible functions ------------------------
-
-template <class T> List<T> &List<T>::operator=(const List<T> &b)
-{
-  if (this != &b)   {
-    Node *n = m_head;
-    while (n) {
-      Node *m_next = n->m_next;
-      delete n;
-      n = m_next;
-    }
-
-    m_length = b.m_length;
-    m_currentIndex = b.m_currentIndex;
-    if (m_length)   {
-      Node *n = b.m_head;
-      m_head = new Node(n->m_data, 0, 0);
-      if (b.m_currentNode == n) m_currentNode = m_head;
-      n = n->m_next;
-      m_tail = m_head;
-      while (n)  {
-	m_tail->m_next = new Node(n->m_data, m_tail, 0);
-	if (b.m_currentNode == n) m_currentNode = m_tail->m_next;
-	n = n->m_next;
-	m_tail = m_tail->m_next;
-      }
-    }
-    else
-      m_head = m_tail = 0;
-  }
-  return *this;
-}
-
-template <class T> bool List<T>::operator==(const List<T> &b) const
-{
-  if (m_length != b.m_length) return false;
-  for (Node *m = m_head, *n = b.m_head; m; m = m->m_next, n = n->m_next)
-    if (m->m_data != n->m_data)  return false;
-  return true;
-}
-
-template <class T> bool List<T>::operator!=(const List<T> &b) const
-{
-  return !(*this == b);
-}
-
-template <class T> const T &List<T>::operator[](int num) const
-{
-  if (num < 1 || num > m_length)    throw IndexException();
-
-  int i;
-  Node *n;
-  if( num < m_currentIndex )
-    for (i = m_currentIndex, n = m_currentNode; i > num; i--, n = n->m_prev);
-  else
-    for (i = m_currentIndex, n = m_currentNode; i < num; i++, n = n->m_next);
-  return n->m_data;
-}
-
-template <class T> T &List<T>::operator[](int num)
-{
-  if (num < 1 || num > m_length)   throw IndexException();
-  Node *n;
-  int i;
-  if( num < m_currentIndex )
-    for (i = m_currentIndex, n = m_currentNode; i > num; i--, n = n->m_prev);
-  else
-    for (i = m_currentIndex, n = m_currentNode; i < num; i++, n = n->m_next);
-  m_currentIndex = i;
-  m_currentNode = n;
-  return n->m_data;
-}
-
 template <class T> List<T> List<T>::operator+(const List<T> &b) const
 {
   List<T> result(*this);
-  Node *n = b.m_head;
-  while (n)  {
-    result.Append(n->data);
-    n = n->m_next;
-  }
+  result += b;
   return result;
 }
 
 template <class T> List<T> &List<T>::operator+=(const List<T> &b)
 {
-  Node *n = b.m_head;
-  
-  while (n)  {
-    Append(n->m_data);
-    n = n->m_next;
+  // Taking the length first allows a list to be appended to itself.
+  // Space is reserved geometrically, so that appending many short
+  // lists in turn takes linear time overall.
+  size_t length = b.m_items.size();
+  if (m_items.size() + length > m_items.capacity()) {
+    m_items.reserve(std::max(m_items.size() + length, 2 * m_items.capacity()));
+  }
+  for (size_t i = 0; i < length; i++) {
+    m_items.push_back(b.m_items[i]);
   }
   return *this;
 }
 
-template <class T> int List<T>::Append(const T &t)
-{
-  return InsertAt(t, m_length + 1);
-}
+//
+// Some of the element types stored in lists cannot be assigned, which
+// std::vector::insert() and erase() require.  Inserting or removing an
+// element other than the last therefore copies the elements into a new
+// vector, which takes time linear in the length of the list, just as
+// shifting the elements would.
+//
 
 template <class T> int List<T>::Insert(const T &t, int n)
 {
-  return InsertAt(t, (n < 1) ? 1 : ((n > m_length + 1) ? m_length + 1 : n));
+  if (n < 1)  n = 1;
+  else if (n > Length() + 1)  n = Length() + 1;
+  if (n == Length() + 1) {
+    m_items.push_back(t);
+    return n;
+  }
+
+  std::vector<T> items;
+  items.reserve(m_items.size() + 1);
+  for (int i = 1; i < n; i++)  items.push_back(m_items[i-1]);
+  items.push_back(t);
+  for (int i = n; i <= Length(); i++)  items.push_back(m_items[i-1]);
+  m_items.swap(items);
+  return n;
 }
 
-template <class T> T List<T>::Remove(int num)
+template <class T> T List<T>::Remove(int n)
 {
-  if (num < 1 || num > m_length)   throw IndexException();
-  Node *n;
-  int i;
-
-  if( num < m_currentIndex )
-    for (i = m_currentIndex, n = m_currentNode; i > num; i--, n = n->m_prev);
-  else
-    for (i = m_currentIndex, n = m_currentNode; i < num; i++, n = n->m_next);
-
-  if (n->m_prev)
-    n->m_prev->m_next = n->m_next;
-  else
-    m_head = n->m_next;
-  if (n->m_next)
-    n->m_next->m_prev = n->m_prev;
-  else
-    m_tail = n->m_prev;
+  if (n < 1 || n > Length())  throw IndexException();
+  T ret(m_items[n-1]);
+  if (n == Length()) {
+    m_items.pop_back();
+    return ret;
+  }
 
-  m_length--;
-  m_currentIndex = i;
-  m_currentNode = n->m_next;
-  if (m_currentIndex > m_length) {
-    m_currentIndex = m_length;
-    m_currentNode = m_tail;
+  std::vector<T> items;
+  items.reserve(m_items.size() - 1);
+  for (int i = 1; i <= Length(); i++) {
+    if (i != n)  items.push_back(m_items[i-1]);
   }
-  T ret = n->m_data;
-  delete n;
+  m_items.swap(items);
   return ret;
 }
 
 template <class T> int List<T>::Find(const T &t) const
 {
-  if (m_length == 0)  return 0;
-  Node *n = m_head;
-  for (int i = 1; n; i++, n = n->m_next)
-    if (n->m_data == t)   return i;
-  return 0;
-}
-
-template <class T> bool List<T>::Contains(const T &t) const
-{
-  return (Find(t) != 0);
-}
-
-template <class T> void List<T>::push_back(const T &val)
-{
-  InsertAt(val, m_length + 1);
-}
-
-template <class T> void List<T>::clear(void)
-{
-  Node *n = m_head;
-  while (n)  {
-    Node *m_next = n->m_next;
-    delete n;
-    n = m_next;
+  for (size_t i = 0; i < m_items.size(); i++) {
+    if (m_items[i] == t)  return i + 1;
   }
-  m_length = 0;
-  m_head = 0;
-  m_tail = 0;
-  m_currentIndex = 0;
-  m_currentNode = 0;
+  return 0;
 }
 
 }
 
 #endif // LIBGAMBIT_LIST_H
-
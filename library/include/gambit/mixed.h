@@ -52,6 +52,7 @@ public:
   virtual T GetPayoff(int pl) const = 0;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &) const = 0;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &, const GameStrategy &) const = 0;
+  virtual void GetPayoffDerivs(Matrix<T> &, Array<Matrix<T> > *) const;
 };
 
 template <class T> class TreeMixedStrategyProfileRep 
@@ -72,16 +73,27 @@ public:
 template <class T> class TableMixedStrategyProfileRep
   : public MixedStrategyProfileRep<T> {
 private:
-  /// @name Private recursive payoff functions
+  /// The strategies a player uses in a contraction, given as offsets
+  /// into the game's payoff tensor along with their probabilities
+  struct Factor {
+    std::vector<long> m_offsets;
+    std::vector<T> m_probs;
+  };
+
+  /// @name Private payoff contraction functions
   //@{
-  /// Recursive computation of payoff to player pl
-  T GetPayoff(int pl, int index, int i) const;
-  /// Recursive computation of payoff derivative
-  void GetPayoffDeriv(int pl, int const_pl, int cur_pl, long index,
-		      const T &prob, T &value) const;
-  /// Recursive computation of payoff second derivative
-  void GetPayoffDeriv(int pl, int const_pl1, int const_pl2, 
-		      int cur_pl, long index, const T &prob, T &value) const;
+  /// Collects the strategies played by each player.  If p_positive is
+  /// true, only strategies with positive probability are used; otherwise,
+  /// all those with nonzero probability.  The strategies p_fixed1 and
+  /// p_fixed2, if given, are played with probability one by their players.
+  void GetFactors(std::vector<Factor> &p_factors, bool p_positive,
+		  GameStrategyRep *p_fixed1 = 0,
+		  GameStrategyRep *p_fixed2 = 0) const;
+  /// Contracts the payoff tensor over players 1 through p_player
+  T Contract(const T *p_tensor, const std::vector<Factor> &p_factors,
+	     int p_player, long p_index) const;
+  /// Returns the payoff tensor of player pl in the underlying game
+  const T *GetPayoffTensor(int pl) const;
   //@}
 
 public:
@@ -94,6 +106,7 @@ public:
   virtual T GetPayoff(int pl) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &, const GameStrategy &) const;
+  virtual void GetPayoffDerivs(Matrix<T> &, Array<Matrix<T> > *) const;
 };
 
 template <class T> class AggMixedStrategyProfileRep
@@ -253,6 +266,19 @@ public:
   T GetPayoff(const GameStrategy &p_strategy) const
   { return GetPayoffDeriv(p_strategy->GetPlayer()->GetNumber(), p_strategy); }
 
+  /// \brief Computes the payoff derivatives for all players at once
+  ///
+  /// Sets p_values(pl, i) to GetPayoffDeriv(pl, s), where s is the i'th
+  /// strategy in the profile; for one of pl's own strategies, this is the
+  /// payoff to pl of playing s against the profile.  If p_derivs is not
+  /// null, (*p_derivs)[pl](i, j) is also set to GetPayoffDeriv(pl, s, t),
+  /// where s and t are the i'th and j'th strategies in the profile.
+  /// For strategic games, all of these are computed in a single pass
+  /// over the table of payoffs.
+  void GetPayoffDerivs(Matrix<T> &p_values, 
+		       Array<Matrix<T> > *p_derivs = 0) const
+  { m_rep->GetPayoffDerivs(p_values, p_derivs); }
+
   /// \brief Computes the Lyapunov value of the profile
   ///
   /// Computes the Lyapunov value of the profile.  This is a nonnegative
@@ -65,8 +65,11 @@ private:
 
 template <class T> class EnumMixedStrategySolver : public StrategySolver<T> {
 public:
-  EnumMixedStrategySolver(shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0)
-    : StrategySolver<T>(p_onEquilibrium) {}
+  /// Creates a solver which enumerates the vertices of each player's
+  /// polytope in p_numThreads threads
+  EnumMixedStrategySolver(shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0,
+			  int p_numThreads = 1)
+    : StrategySolver<T>(p_onEquilibrium), m_numThreads(p_numThreads) {}
   virtual ~EnumMixedStrategySolver() { }
 
   shared_ptr<EnumMixedStrategySolution<T> > SolveDetailed(const Game &p_game) const;
@@ -75,6 +78,8 @@ public:
   
   
 private:
+  int m_numThreads;
+
   /// Implement fuzzy equality for floating-point version when testing Nashness
   static bool EqZero(const T &x);
 };
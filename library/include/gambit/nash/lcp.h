@@ -30,53 +30,62 @@ namespace Gambit {
 namespace linalg {
 template <class T> class LHTableau;
 template <class T> class LemkeTableau;
+template <class T> class BFS;
 }
 
 namespace Nash {
  
 template <class T> class NashLcpStrategySolver : public StrategySolver<T> {
 public:
+  /// Creates a solver which follows the paths leaving each equilibrium
+  /// in p_numThreads threads
   NashLcpStrategySolver(int p_stopAfter, int p_maxDepth,
-			Gambit::shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0)
+			Gambit::shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0,
+			int p_numThreads = 1)
     : StrategySolver<T>(p_onEquilibrium),
-      m_stopAfter(p_stopAfter), m_maxDepth(p_maxDepth) { }
+      m_stopAfter(p_stopAfter), m_maxDepth(p_maxDepth),
+      m_numThreads(p_numThreads) { }
   virtual ~NashLcpStrategySolver()  { }
 
   virtual List<MixedStrategyProfile<T> > Solve(const Game &) const;
 
 private:
-  int m_stopAfter, m_maxDepth;
+  int m_stopAfter, m_maxDepth, m_numThreads;
 
   class Solution;
+  class Path;
 
-  bool OnBFS(const Game &, linalg::LHTableau<T> &, Solution &) const;
+  bool OnBFS(const Game &, const linalg::BFS<T> &, Solution &) const;
   void AllLemke(const Game &, int j, linalg::LHTableau<T> &, Solution &, int) const;
 };
 
  
 template <class T> class NashLcpBehaviorSolver : public BehavSolver<T> {
 public:
+  /// Creates a solver which follows the paths leaving each equilibrium
+  /// in p_numThreads threads
   NashLcpBehaviorSolver(int p_stopAfter, int p_maxDepth,
-			Gambit::shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0)
+			Gambit::shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0,
+			int p_numThreads = 1)
     : BehavSolver<T>(p_onEquilibrium),
-      m_stopAfter(p_stopAfter), m_maxDepth(p_maxDepth) { }
+      m_stopAfter(p_stopAfter), m_maxDepth(p_maxDepth),
+      m_numThreads(p_numThreads) { }
   virtual ~NashLcpBehaviorSolver()  { }
 
   virtual List<MixedBehaviorProfile<T> > Solve(const BehaviorSupportProfile &) const;
 
 private:
-  int m_stopAfter, m_maxDepth;
+  int m_stopAfter, m_maxDepth, m_numThreads;
 
   class Solution;
+  class Path;
 
-  void FillTableau(const BehaviorSupportProfile &, Matrix<T> &, const GameNode &, T,
-		   int, int, int, int, Solution &) const;
+  void FillTableau(Matrix<T> &, const Solution &) const;
   void AllLemke(const BehaviorSupportProfile &, int dup, Gambit::linalg::LemkeTableau<T> &B,
-	       int depth, Matrix<T> &, Solution &) const; 
-  void GetProfile(const BehaviorSupportProfile &, const Gambit::linalg::LemkeTableau<T> &tab, 
+	       int depth, const Matrix<T> &, Solution &) const; 
+  void GetProfile(const Gambit::linalg::LemkeTableau<T> &tab, 
 		  MixedBehaviorProfile<T> &, const Vector<T> &, 
-		  const GameNode &n, int, int,
-		  Solution &) const;
+		  const Solution &) const;
 };
 
 }  // end namespace Nash
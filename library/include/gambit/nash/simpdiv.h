@@ -33,20 +33,30 @@ namespace Nash {
 /// mixed strategy solutions to general finite n-person games.  It is based on
 /// van Der Laan, Talman and van Der Heyden, Math in Oper Res, 1987.
 ///
-class NashSimpdivStrategySolver : public StrategySolver<Rational> {
+/// The subdivision may be carried out in exact (Rational) or in
+/// floating-point (double) arithmetic.  In floating point, the point
+/// found is moved to the nearest point of the final grid, and checked
+/// in exact arithmetic; if it is not an approximate equilibrium
+/// there, the subdivision is continued in exact arithmetic from it.
+///
+template <class T> class NashSimpdivStrategySolver : public StrategySolver<T> {
+  template <class U> friend class NashSimpdivStrategySolver;
 public:
   NashSimpdivStrategySolver(int p_gridResize = 2, int p_leashLength = 0,
 			    bool p_verbose = false,
-			    shared_ptr<StrategyProfileRenderer<Rational> > p_onEquilibrium = 0)
-    : StrategySolver<Rational>(p_onEquilibrium),
+			    shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0)
+    : StrategySolver<T>(p_onEquilibrium),
       m_gridResize(p_gridResize),
       m_leashLength((p_leashLength > 0) ? p_leashLength : 32000),
       m_verbose(p_verbose)
   { }
   virtual ~NashSimpdivStrategySolver() { }
 
-  List<MixedStrategyProfile<Rational> > Solve(const MixedStrategyProfile<Rational> &p_start) const;
-  List<MixedStrategyProfile<Rational> > Solve(const Game &p_game) const;
+  /// Computes an equilibrium starting from p_start, whose entries
+  /// should be multiples of a common fraction; this gives the size
+  /// of the initial grid
+  List<MixedStrategyProfile<T> > Solve(const MixedStrategyProfile<Rational> &p_start) const;
+  List<MixedStrategyProfile<T> > Solve(const Game &p_game) const;
 
 
 private:
@@ -56,24 +66,26 @@ private:
   class State {
   public:
     int t, ibar;
-    Rational d, pay, maxz, bestz;
+    T d, pay, maxz, bestz;
     
     State(void) : t(0), ibar(1), bestz(1.0e30) { }
-    Rational getlabel(MixedStrategyProfile<Rational> &yy, Array<int> &, 
-		      PVector<Rational> &);
+    T getlabel(MixedStrategyProfile<T> &yy, Array<int> &, PVector<T> &);
   };
 
-  Rational Simplex(MixedStrategyProfile<Rational> &, const Rational &d) const;
-  void update(State &, RectArray<int> &, RectArray<int> &, PVector<Rational> &,
+  void Subdivide(MixedStrategyProfile<T> &, Rational &d) const;
+  void Certify(MixedStrategyProfile<T> &, Rational &d) const;
+  T Simplex(MixedStrategyProfile<T> &, const T &d) const;
+  void update(State &, RectArray<int> &, RectArray<int> &, PVector<T> &,
 	      const PVector<int> &, int j, int i) const;
-  void getY(State &, MixedStrategyProfile<Rational> &x, PVector<Rational> &, 
+  void getY(State &, MixedStrategyProfile<T> &x, PVector<T> &, 
 	    const PVector<int> &, const PVector<int> &, 
-	    const PVector<Rational> &, const RectArray<int> &, int k) const;
+	    const PVector<T> &, const RectArray<int> &, int k) const;
   void getnexty(State &, 
-		MixedStrategyProfile<Rational> &x, const RectArray<int> &,
+		MixedStrategyProfile<T> &x, const RectArray<int> &,
 		const PVector<int> &, int i) const;
   int get_c(int j, int h, int nstrats, const PVector<int> &) const;
   int get_b(int j, int h, int nstrats, const PVector<int> &) const;
+  bool OutOfBounds(const T &y, const T &v, const T &d) const;
 };
 
 }  // end namespace Gambit::Nash
@@ -23,8 +23,13 @@
 #ifndef LIBGAMBIT_NUMBER_H
 #define LIBGAMBIT_NUMBER_H
 
+#include <vector>
+
 namespace Gambit {
 
+class BinaryFileWriter;
+class BinaryFileReader;
+
 /// This simple class stores a numerical datum.
 class Number {
 private:
@@ -55,6 +60,78 @@ public:
   operator const std::string &(void) const { return m_text; }
 };
 
+/// \brief Compact storage for the payoffs of the outcomes of a game
+///
+/// Payoffs are stored by player, in contiguous columns of doubles and
+/// Rationals indexed by outcome number.  The text a payoff was entered
+/// with is not kept; instead, the number of decimal places used is
+/// remembered, so that an equivalent text representation can be
+/// rebuilt on demand (for example, when writing a game file).
+class PayoffTable {
+private:
+  int m_numOutcomes;
+  /// Incremented on every change, so derived data can detect staleness
+  unsigned long m_revision;
+  std::vector<std::vector<double> > m_doubles;
+  std::vector<std::vector<Rational> > m_rationals;
+  /// Decimal places in the entered text (zero for integer/rational format)
+  std::vector<std::vector<unsigned char> > m_places;
+  
+public:
+  /// @name Lifecycle
+  //@{
+  PayoffTable(void) : m_numOutcomes(0), m_revision(0) { }
+  PayoffTable(int p_players, int p_outcomes)
+    : m_numOutcomes(p_outcomes), m_revision(0),
+      m_doubles(p_players, std::vector<double>(p_outcomes, 0.0)),
+      m_rationals(p_players, std::vector<Rational>(p_outcomes, Rational(0))),
+      m_places(p_players, std::vector<unsigned char>(p_outcomes, 0))
+  { }
+  //@}
+
+  /// @name Dimensions
+  //@{
+  int NumPlayers(void) const { return m_doubles.size(); }
+  int NumOutcomes(void) const { return m_numOutcomes; }
+  /// Returns a counter which changes whenever any payoff is changed
+  unsigned long GetRevision(void) const { return m_revision; }
+
+  /// Adds a player, with payoffs of zero in all outcomes
+  void AddPlayer(void);
+  /// Adds an outcome at the end, with payoffs of zero to all players
+  void AddOutcome(void);
+  /// Removes the outcome with index p_outcome, renumbering those after it
+  void RemoveOutcome(int p_outcome);
+  //@}
+
+  /// @name Accessing payoffs
+  //@{
+  const double &GetDouble(int p_outcome, int p_player) const
+  { return m_doubles[p_player-1][p_outcome-1]; }
+  const Rational &GetRational(int p_outcome, int p_player) const
+  { return m_rationals[p_player-1][p_outcome-1]; }
+  /// Rebuilds the text representation of the payoff
+  std::string GetText(int p_outcome, int p_player) const;
+
+  /// Sets a payoff from its text representation, in either decimal or
+  /// rational format.  Throws a ValueException if the text cannot be
+  /// interpreted as a number.
+  void SetPayoff(int p_outcome, int p_player, const std::string &p_value);
+  /// Sets all payoffs of an outcome to those of an outcome in another
+  /// table with the same number of players, without reparsing them
+  void CopyOutcome(int p_outcome, const PayoffTable &p_from, int p_fromOutcome);
+  //@}
+
+  /// @name Binary files
+  //@{
+  /// Writes the payoffs of all outcomes, column by column
+  void WriteBinary(BinaryFileWriter &) const;
+  /// Replaces the contents of the table with payoffs read from a binary
+  /// file; throws an InvalidFileException if the data are inconsistent
+  void ReadBinary(BinaryFileReader &);
+  //@}
+};
+
 }
 
 #endif // LIBGAMBIT_NUMBER_H
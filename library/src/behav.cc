@@ -20,9 +20,84 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <map>
+
 #include "gambit/gambit.h"
 #include "gambit/behav.imp"
 
+namespace Gambit {
+
+//========================================================================
+//                      class PlayerSequenceTable
+//========================================================================
+
+//
+// The nodes are visited in preorder, so the sequence leading to a node
+// is known when it is reached.  The sequences following a node of the
+// player are numbered when the first node with the same sequence and
+// information set is reached, at which point the strategies playing the
+// node's sequence are split among them according to their action at
+// the information set.  With perfect recall, this happens exactly once
+// for each information set of the player.
+//
+PlayerSequenceTable::PlayerSequenceTable(const CompiledGameTree &p_tree,
+					 const StrategySupportProfile &p_support,
+					 int p_player)
+  : m_player(p_player),
+    m_sequence(p_tree.NumNodes()), m_next(p_tree.NumNodes()),
+    m_strategies(1)
+{
+  const Array<GameStrategy> &strategies =
+    p_support.Strategies(p_support.GetGame()->GetPlayer(p_player));
+  for (int st = 1; st <= strategies.Length(); st++) {
+    m_strategies[0].push_back(st);
+  }
+
+  std::map<std::pair<int, int>, int> split;
+  for (int node = 1; node <= p_tree.NumNodes(); node++) {
+    int parent = p_tree.GetParent(node);
+    if (parent == 0) {
+      m_sequence[node] = 0;
+    }
+    else if (m_next[parent] > 0) {
+      int iset = p_tree.GetInfoset(parent);
+      m_sequence[node] = GetSequence(parent,
+				     p_tree.GetPriorAction(node) - 
+				     p_tree.GetFirstAction(iset) + 1);
+    }
+    else {
+      m_sequence[node] = m_sequence[parent];
+    }
+
+    int iset = p_tree.GetInfoset(node);
+    m_next[node] = 0;
+    if (!iset || p_tree.GetInfosetPlayer(iset) != p_player)  continue;
+
+    std::pair<int, int> key(m_sequence[node], iset);
+    std::map<std::pair<int, int>, int>::const_iterator known = split.find(key);
+    if (known != split.end()) {
+      m_next[node] = known->second;
+      continue;
+    }
+
+    int first = m_strategies.size();
+    m_next[node] = split[key] = first;
+    m_strategies.resize(first + p_tree.NumActions(iset));
+    int number = p_tree.GetInfosetRep(iset)->GetNumber();
+    const std::vector<int> &consistent = m_strategies[m_sequence[node]];
+    for (size_t i = 0; i < consistent.size(); i++) {
+      // Reduced strategies do not specify actions at information sets
+      // they cannot reach; these have an action of zero
+      int act = strategies[consistent[i]]->m_behav[number];
+      if (act > 0) {
+	m_strategies[first + act - 1].push_back(consistent[i]);
+      }
+    }
+  }
+}
+
+}  // end namespace Gambit
+
 template class Gambit::MixedBehaviorProfile<double>;
 template class Gambit::MixedBehaviorProfile<Gambit::Rational>;
 
@@ -48,13 +48,13 @@ BehaviorSupportProfile::BehaviorSupportProfile(const Game &p_efg)
   // Initialize the list of reachable information sets and nodes
   for (int pl = 0; pl <= GetGame()->NumPlayers(); pl++) {
     GamePlayer player = (pl == 0) ? GetGame()->GetChance() : GetGame()->GetPlayer(pl);
-    List<bool> is_players_infoset_active;
-    List<List<bool> > is_players_node_active;
+    Array<bool> is_players_infoset_active;
+    Array<Array<bool> > is_players_node_active;
 
     for (int iset = 1; iset <= player->NumInfosets(); iset++) {
       is_players_infoset_active.Append(false);
 
-      List<bool> is_infosets_node_active;
+      Array<bool> is_infosets_node_active;
       for (int n = 1; n <= player->GetInfoset(iset)->NumMembers()
 ; n++)
 	is_infosets_node_active.Append(false);
@@ -758,4 +758,108 @@ bool BehaviorSupportProfile::HasActiveActionsAtActiveInfosetsAndNoOthers(void) c
   return true;
 }
 
+//========================================================================
+//                          class SequenceForm
+//========================================================================
+
+SequenceForm::SequenceForm(const BehaviorSupportProfile &p_support)
+  : m_support(p_support),
+    m_infosets(p_support.GetGame()->NumPlayers()),
+    m_infosetIndex(p_support.GetGame()->NumInfosets()),
+    m_parent(p_support.GetGame()->NumPlayers()),
+    m_offset(p_support.GetGame()->NumPlayers()),
+    m_sequenceInfoset(p_support.GetGame()->NumPlayers()),
+    m_sequenceAction(p_support.GetGame()->NumPlayers())
+{
+  Game efg = p_support.GetGame();
+  if (!efg->IsPerfectRecall()) {
+    throw UndefinedException("The sequence form is only defined for games with perfect recall.");
+  }
+
+  m_infosetIndex = 0;
+  p_support.ReachableInfosets(efg->GetRoot(), m_infosetIndex);
+  for (int pl = 1; pl <= efg->NumPlayers(); pl++) {
+    GamePlayer player = efg->GetPlayer(pl);
+    m_sequenceInfoset[pl].Append(0);
+    m_sequenceAction[pl].Append(0);
+    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
+      if (!m_infosetIndex(pl, iset))  continue;
+      GameInfoset infoset = player->GetInfoset(iset);
+      m_infosetIndex(pl, iset) = m_infosets[pl].Append(infoset);
+      m_parent[pl].Append(0);
+      m_offset[pl].Append(m_sequenceInfoset[pl].Length());
+      for (int act = 1; act <= p_support.NumActions(infoset); act++) {
+	m_sequenceInfoset[pl].Append(m_infosetIndex(pl, iset));
+	m_sequenceAction[pl].Append(act);
+      }
+    }
+  }
+
+  std::vector<int> sequences(efg->NumPlayers(), 1);
+  std::map<std::vector<int>, int> entries;
+  BuildEntries(efg->GetRoot(), Rational(1), sequences, entries);
+
+  // Lay out the entries in order of their (reversed) profiles
+  std::vector<Rational> payoffs, probs;
+  payoffs.swap(m_entryPayoffs);
+  probs.swap(m_entryProbs);
+  m_entrySequences.reserve(entries.size() * efg->NumPlayers());
+  m_entryPayoffs.reserve(payoffs.size());
+  m_entryProbs.reserve(probs.size());
+  for (std::map<std::vector<int>, int>::const_iterator entry = entries.begin();
+       entry != entries.end(); ++entry) {
+    m_entrySequences.insert(m_entrySequences.end(),
+			    entry->first.rbegin(), entry->first.rend());
+    m_entryPayoffs.insert(m_entryPayoffs.end(),
+			  payoffs.begin() + entry->second * efg->NumPlayers(),
+			  payoffs.begin() + (entry->second + 1) * efg->NumPlayers());
+    m_entryProbs.push_back(probs[entry->second]);
+  }
+}
+
+void SequenceForm::BuildEntries(const GameNode &p_node, const Rational &p_prob,
+				std::vector<int> &p_sequences,
+				std::map<std::vector<int>, int> &p_entries)
+{
+  GameOutcome outcome = p_node->GetOutcome();
+  if (outcome) {
+    int players = p_sequences.size();
+    std::vector<int> key(p_sequences.rbegin(), p_sequences.rend());
+    std::map<std::vector<int>, int>::iterator entry = p_entries.find(key);
+    if (entry == p_entries.end()) {
+      entry = p_entries.insert(std::make_pair(key, (int) m_entryProbs.size())).first;
+      m_entryPayoffs.resize(m_entryPayoffs.size() + players, Rational(0));
+      m_entryProbs.push_back(Rational(0));
+    }
+    for (int pl = 1; pl <= players; pl++) {
+      m_entryPayoffs[entry->second * players + pl - 1] += 
+	p_prob * outcome->GetPayoff<Rational>(pl);
+    }
+    m_entryProbs[entry->second] += p_prob;
+  }
+
+  if (p_node->NumChildren() == 0)  return;
+
+  GameInfoset infoset = p_node->GetInfoset();
+  if (infoset->GetPlayer()->IsChance()) {
+    for (int act = 1; act <= infoset->NumActions(); act++) {
+      BuildEntries(p_node->GetChild(act),
+		   p_prob * infoset->GetActionProb(act, Rational(0)),
+		   p_sequences, p_entries);
+    }
+  }
+  else {
+    int pl = infoset->GetPlayer()->GetNumber();
+    int index = GetInfosetIndex(infoset);
+    int parent = p_sequences[pl - 1];
+    m_parent[pl][index] = parent;
+    for (int act = 1; act <= m_support.NumActions(infoset); act++) {
+      p_sequences[pl - 1] = GetSequence(pl, index, act);
+      BuildEntries(p_node->GetChild(m_support.GetAction(infoset, act)->GetNumber()),
+		   p_prob, p_sequences, p_entries);
+    }
+    p_sequences[pl - 1] = parent;
+  }
+}
+
 } // end namespace Gambit
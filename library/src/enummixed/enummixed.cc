@@ -20,6 +20,12 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <atomic>
+#include <exception>
+#include <limits>
+#include <thread>
+#include <vector>
+
 #include "gambit/gambit.h"
 #include "gambit/linalg/vertenum.imp"
 #include "gambit/nash/enummixed.h"
@@ -30,6 +36,155 @@ namespace Nash {
 
 using namespace Gambit::linalg;
 
+namespace {
+
+///
+/// The set of labels of a vertex of one of the players' polytopes,
+/// stored as a bit vector.  Label k stands for the first player's k'th
+/// strategy, and label m1+k for the second player's k'th strategy.
+/// A vertex carries a label if the variable or slack belonging to
+/// that strategy is zero there.
+///
+class LabelSet {
+public:
+  explicit LabelSet(int p_numLabels)
+    : m_words((p_numLabels + s_bits - 1) / s_bits, 0UL) { }
+
+  void Insert(int p_label)
+  { m_words[(p_label - 1) / s_bits] |= 1UL << ((p_label - 1) % s_bits); }
+  bool Contains(int p_label) const
+  { return m_words[(p_label - 1) / s_bits] & (1UL << ((p_label - 1) % s_bits)); }
+
+  /// Returns true if together the sets carry every label in p_all
+  bool Complements(const LabelSet &p_other, const LabelSet &p_all) const
+  {
+    for (size_t i = 0; i < m_words.size(); i++) {
+      if ((m_words[i] | p_other.m_words[i]) != p_all.m_words[i]) {
+	return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  static const int s_bits = std::numeric_limits<unsigned long>::digits;
+  std::vector<unsigned long> m_words;
+};
+
+///
+/// Finds the complementary pairs among the vertices of the two
+/// polytopes.  The vertices of the second polytope are put in a
+/// bucket for each label they carry.  A vertex of the first polytope
+/// needs to be compared only against the smallest bucket of a label
+/// it does not carry itself.  The vertices of the first polytope are
+/// shared out among the threads; the matches of each are listed in
+/// increasing order, so the result does not depend on the number
+/// of threads.
+///
+class ComplementMatcher {
+public:
+  ComplementMatcher(const std::vector<LabelSet> &p_labels1,
+		    const std::vector<LabelSet> &p_labels2,
+		    int p_numLabels);
+
+  void Run(int p_numThreads);
+  /// Returns the indices of the vertices matching the p_index'th vertex
+  /// of the first polytope
+  const std::vector<int> &GetMatches(int p_index) const
+  { return m_matches[p_index]; }
+
+private:
+  const std::vector<LabelSet> &m_labels1, &m_labels2;
+  int m_numLabels;
+  LabelSet m_all;
+  std::vector<std::vector<int> > m_buckets, m_matches;
+
+  void Match(int p_index);
+  static void MatchAll(ComplementMatcher *p_matcher, std::atomic<int> *p_next,
+		       std::exception_ptr *p_error);
+};
+
+ComplementMatcher::ComplementMatcher(const std::vector<LabelSet> &p_labels1,
+				     const std::vector<LabelSet> &p_labels2,
+				     int p_numLabels)
+  : m_labels1(p_labels1), m_labels2(p_labels2), m_numLabels(p_numLabels),
+    m_all(p_numLabels), m_buckets(p_numLabels + 1),
+    m_matches(p_labels1.size())
+{
+  for (int k = 1; k <= m_numLabels; k++) {
+    m_all.Insert(k);
+  }
+  for (size_t i = 0; i < m_labels2.size(); i++) {
+    for (int k = 1; k <= m_numLabels; k++) {
+      if (m_labels2[i].Contains(k)) {
+	m_buckets[k].push_back(i);
+      }
+    }
+  }
+}
+
+void ComplementMatcher::Match(int p_index)
+{
+  const LabelSet &labels = m_labels1[p_index];
+  int bucket = 0;
+  for (int k = 1; k <= m_numLabels; k++) {
+    if (!labels.Contains(k) &&
+	(bucket == 0 || m_buckets[k].size() < m_buckets[bucket].size())) {
+      bucket = k;
+    }
+  }
+
+  if (bucket == 0) {
+    // This vertex carries every label; any vertex complements it
+    for (size_t i = 0; i < m_labels2.size(); i++) {
+      m_matches[p_index].push_back(i);
+    }
+    return;
+  }
+  for (size_t j = 0; j < m_buckets[bucket].size(); j++) {
+    int i = m_buckets[bucket][j];
+    if (labels.Complements(m_labels2[i], m_all)) {
+      m_matches[p_index].push_back(i);
+    }
+  }
+}
+
+void ComplementMatcher::MatchAll(ComplementMatcher *p_matcher,
+				 std::atomic<int> *p_next,
+				 std::exception_ptr *p_error)
+{
+  try {
+    for (int i = (*p_next)++; i < (int) p_matcher->m_labels1.size(); 
+	 i = (*p_next)++) {
+      p_matcher->Match(i);
+    }
+  }
+  catch (...) {
+    *p_error = std::current_exception();
+  }
+}
+
+void ComplementMatcher::Run(int p_numThreads)
+{
+  std::atomic<int> next(0);
+  std::vector<std::exception_ptr> errors(std::max(p_numThreads, 1));
+  std::vector<std::thread> threads;
+  for (int i = 1; i < p_numThreads; i++) {
+    threads.push_back(std::thread(MatchAll, this, &next, &errors[i]));
+  }
+  MatchAll(this, &next, &errors[0]);
+  for (size_t i = 0; i < threads.size(); i++) {
+    threads[i].join();
+  }
+  for (size_t i = 0; i < errors.size(); i++) {
+    if (errors[i]) {
+      std::rethrow_exception(errors[i]);
+    }
+  }
+}
+
+}  // end anonymous namespace
+
 template <class T> List<List<MixedStrategyProfile<T> > > 
 EnumMixedStrategySolution<T>::GetCliques(void) const
 {
@@ -118,8 +273,8 @@ EnumMixedStrategySolver<T>::SolveDetailed(const Game &p_game) const
   b2 = (T) -1;
 
   // enumerate vertices of A1 x + b1 <= 0 and A2 x + b2 <= 0
-  VertexEnumerator<T> poly1(A1, b1);
-  VertexEnumerator<T> poly2(A2, b2);
+  VertexEnumerator<T> poly1(A1, b1, m_numThreads);
+  VertexEnumerator<T> poly2(A2, b2, m_numThreads);
 
   const List<BFS<T> > &verts1(poly1.VertexList());
   const List<BFS<T> > &verts2(poly2.VertexList());
@@ -131,64 +286,78 @@ EnumMixedStrategySolver<T>::SolveDetailed(const Game &p_game) const
   for (int i = 1; i <= vert1id.Length(); vert1id[i++] = 0);
   for (int i = 1; i <= vert2id.Length(); vert2id[i++] = 0);
 
-  int i = 0;
+  // Label the vertices other than the origin.  The variables of verts2
+  // belong to the first player's strategies and its slacks to the
+  // second player's, and the other way round for verts1.
+  // The pair is Nash if it is complementary, since it is feasible.
+  int m1 = p_game->Players()[1]->Strategies().size();
+  int m2 = p_game->Players()[2]->Strategies().size();
+  std::vector<LabelSet> labels1, labels2;
+  for (int i2 = 2; i2 <= solution->m_v2; i2++) {
+    const BFS<T> &bfs = verts2[i2];
+    labels1.push_back(LabelSet(m1 + m2));
+    for (int k = 1; k <= m1; k++) {
+      if (!bfs.count(k) || EqZero(bfs[k]))  labels1.back().Insert(k);
+    }
+    for (int k = 1; k <= m2; k++) {
+      if (!bfs.count(-k) || EqZero(bfs[-k]))  labels1.back().Insert(m1 + k);
+    }
+  }
+  for (int i1 = 2; i1 <= solution->m_v1; i1++) {
+    const BFS<T> &bfs = verts1[i1];
+    labels2.push_back(LabelSet(m1 + m2));
+    for (int k = 1; k <= m2; k++) {
+      if (!bfs.count(k) || EqZero(bfs[k]))  labels2.back().Insert(m1 + k);
+    }
+    for (int k = 1; k <= m1; k++) {
+      if (!bfs.count(-k) || EqZero(bfs[-k]))  labels2.back().Insert(k);
+    }
+  }
+
+  ComplementMatcher matcher(labels1, labels2, m1 + m2);
+  matcher.Run(m_numThreads);
+
   int id1 = 0, id2 = 0;
 
   for (int i2 = 2; i2 <= solution->m_v2; i2++) {
-    BFS<T> bfs1 = verts2[i2];
-    i++;
-    for (int i1 = 2; i1 <= solution->m_v1; i1++) {
-      BFS<T> bfs2 = verts1[i1];
-	
-      // check if solution is nash 
-      // need only check complementarity, since it is feasible
-      bool nash = true;
-      for (size_t k = 1; nash && k <= p_game->Players()[1]->Strategies().size(); k++) {
-	if (bfs1.count(k) && bfs2.count(-k)) {
-	  nash = nash && EqZero(bfs1[k] * bfs2[-k]);
-	}
-      }
+    const BFS<T> &bfs1 = verts2[i2];
+    const std::vector<int> &matches = matcher.GetMatches(i2 - 2);
+    for (size_t j = 0; j < matches.size(); j++) {
+      int i1 = matches[j] + 2;
+      const BFS<T> &bfs2 = verts1[i1];
 
-      for (size_t k = 1; nash && k <= p_game->Players()[2]->Strategies().size(); k++) {
-	if (bfs2.count(k) && bfs1.count(-k)) {
-	  nash = nash && EqZero(bfs2[k] * bfs1[-k]);
+      MixedStrategyProfile<T> profile(p_game->NewMixedStrategyProfile(static_cast<T>(0)));
+      static_cast<Vector<T> &>(profile) = static_cast<T>(0);
+      for (size_t k = 1; k <= p_game->Players()[1]->Strategies().size(); k++) {
+	if (bfs1.count(k)) {
+	  profile[p_game->Players()[1]->Strategies()[k]] = -bfs1[k];
 	}
-      }
-
-      if (nash) {
-	MixedStrategyProfile<T> profile(p_game->NewMixedStrategyProfile(static_cast<T>(0)));
-	static_cast<Vector<T> &>(profile) = static_cast<T>(0);
-	for (size_t k = 1; k <= p_game->Players()[1]->Strategies().size(); k++) {
-	  if (bfs1.count(k)) {
-	    profile[p_game->Players()[1]->Strategies()[k]] = -bfs1[k];
-	  }
-	} 
-	for (size_t k = 1; k <= p_game->Players()[2]->Strategies().size(); k++) {
-	  if (bfs2.count(k)) {
-	    profile[p_game->Players()[2]->Strategies()[k]] = -bfs2[k];
-	  }
-	} 
-	profile.Normalize();
-	solution->m_extremeEquilibria.push_back(profile);
-	this->m_onEquilibrium->Render(profile);
-	  
-	// note: The keys give the mixed strategy associated with each node. 
-	//       The keys should also keep track of the basis
-	//       As things stand now, two different bases could lead to
-	//       the same key... BAD!
-	if (vert1id[i1] == 0) {
-	  id1++;
-	  vert1id[i1] = id1;
-	  solution->m_key2.push_back(profile[p_game->GetPlayer(2)]);
+      } 
+      for (size_t k = 1; k <= p_game->Players()[2]->Strategies().size(); k++) {
+	if (bfs2.count(k)) {
+	  profile[p_game->Players()[2]->Strategies()[k]] = -bfs2[k];
 	}
-	if (vert2id[i2] == 0) {
-	  id2++;
-	  vert2id[i2] = id2;
-	  solution->m_key1.push_back(profile[p_game->GetPlayer(1)]);
-	}
-	solution->m_node1.Append(vert2id[i2]);
-	solution->m_node2.Append(vert1id[i1]);
+      } 
+      profile.Normalize();
+      solution->m_extremeEquilibria.push_back(profile);
+      this->m_onEquilibrium->Render(profile);
+
+      // note: The keys give the mixed strategy associated with each node. 
+      //       The keys should also keep track of the basis
+      //       As things stand now, two different bases could lead to
+      //       the same key... BAD!
+      if (vert1id[i1] == 0) {
+	id1++;
+	vert1id[i1] = id1;
+	solution->m_key2.push_back(profile[p_game->GetPlayer(2)]);
+      }
+      if (vert2id[i2] == 0) {
+	id2++;
+	vert2id[i2] = id2;
+	solution->m_key1.push_back(profile[p_game->GetPlayer(1)]);
       }
+      solution->m_node1.Append(vert2id[i2]);
+      solution->m_node2.Append(vert1id[i1]);
     }
   }
   return solution;
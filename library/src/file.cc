@@ -29,6 +29,9 @@
 #include "gambit/gambit.h"
 // for explicit access to turning off canonicalization
 #include "gambit/gametree.h"
+// for reading games in binary format
+#include "gambit/gametable.h"
+#include "gambit/binfile.h"
   
 
 namespace {
@@ -46,22 +49,31 @@ typedef enum {
 //! including the nonsignificance of whitespace and the possibility of
 //! escaped-quotes within text labels.
 //!
+//! The parser works directly on the contents of the file, held in memory
+//! as a null-terminated buffer.  The text of each token is assigned to a
+//! single string which is reused, so tokens do not allocate memory once
+//! that string has grown to the length of the longest token.
+//!
 class GameParserState {
 private:
-  std::istream &m_file;
+  const char *m_current, *m_end;
 
   int m_currentLine;
   int m_currentColumn;
   GameFileToken m_lastToken;
   std::string m_lastText;
 
-  void ReadChar(char& c);
-  void UnreadChar(void);
+  /// Reads the next character; at the end of the buffer this is '\0'
+  char ReadChar(void)
+  { m_currentColumn++;  return (m_current < m_end) ? *m_current++ : (m_current++, '\0'); }
+  void UnreadChar(void)  { m_current--;  m_currentColumn--; }
   void IncreaseLine(void);
+  /// Reads a run of digits, returning the first character after them
+  char ReadDigits(void);
 
 public:
-  GameParserState(std::istream &p_file) :
-    m_file(p_file), m_currentLine(1), m_currentColumn(1) { }
+  GameParserState(const char *p_begin, const char *p_end) :
+    m_current(p_begin), m_end(p_end), m_currentLine(1), m_currentColumn(1) { }
 
   GameFileToken GetNextToken(void);
   GameFileToken GetCurrentToken(void) const { return m_lastToken; }
@@ -69,36 +81,36 @@ public:
   int GetCurrentColumn(void) const { return m_currentColumn; }
   std::string CreateLineMsg(const std::string &msg);
   const std::string &GetLastText(void) const { return m_lastText; }
+  /// Returns the position in the buffer following the last token read
+  const char *GetPosition(void) const 
+  { return (m_current < m_end) ? m_current : m_end; }
 };
 
-void GameParserState::ReadChar(char& c)
-{
-  m_file.get(c);
-  m_currentColumn++;
-}
-
-void GameParserState::UnreadChar(void)
-{
-  m_file.unget();
-  m_currentColumn--;
-}
-
 void GameParserState::IncreaseLine(void){
   m_currentLine++;
   // Reset column
   m_currentColumn = 1;
 }
 
+char GameParserState::ReadDigits(void)
+{
+  char c = ReadChar();
+  while (isdigit(c)) {
+    c = ReadChar();
+  }
+  return c;
+}
+
 GameFileToken GameParserState::GetNextToken(void)
 {
   char c = ' ';
-  if (m_file.eof()) {
+  if (m_current >= m_end) {
     return (m_lastToken = TOKEN_EOF);
   }
 
   while (isspace(c)) {
-    ReadChar(c);
-    if (!m_file.good()) {
+    c = ReadChar();
+    if (c == '\0') {
       return (m_lastToken = TOKEN_EOF);
     }
     else if (c == '\n') {
@@ -106,6 +118,7 @@ GameFileToken GameParserState::GetNextToken(void)
     }
   }
 
+  const char *start = m_current - 1;
   if (c == '{') {
     return (m_lastToken = TOKEN_LBRACE);
   }
@@ -115,153 +128,73 @@ GameFileToken GameParserState::GetNextToken(void)
   else if (c == ',') {
     return (m_lastToken = TOKEN_COMMA);
   }
-  else if (isdigit(c) || c == '-' || c == '+') {
-    std::string buf;
-    buf += c;
-    ReadChar(c);
-
-    while (!m_file.eof() && m_file.good() && isdigit(c)) {
-      buf += c;
-      ReadChar(c);
+  else if (isdigit(c) || c == '-' || c == '+' || c == '.') {
+    if (c != '.') {
+      c = ReadDigits();
     }
-
-    if (m_file.eof() || !m_file.good()) {
-      m_lastText = buf;
-      return (m_lastToken = TOKEN_NUMBER);
-    }
-
     if (c == '.') {
-      buf += c;
-      ReadChar(c);
-      while (isdigit(c)) {
-        buf += c;
-        ReadChar(c);
-      }
-
-      if (c == 'e' || c == 'E') {
-        buf += c;
-        ReadChar(c);
-        if (c == '+' && c == '-' && !isdigit(c)) {
-          throw InvalidFileException(CreateLineMsg("Invalid Token +/-"));
-        }
-        buf += c;
-        ReadChar(c);
-        while (isdigit(c)) {
-          buf += c;
-          ReadChar(c);
-        }
-      }
-
-      UnreadChar();
-      m_lastText = buf;
-
-      return (m_lastToken = TOKEN_NUMBER);
+      c = ReadDigits();
     }
     else if (c == '/') {
-      buf += c;
-      ReadChar(c);
-      while (isdigit(c)) {
-        buf += c;
-        ReadChar(c);
-      }
-      UnreadChar();
-      m_lastText = buf;
-      return (m_lastToken = TOKEN_NUMBER);
+      c = ReadDigits();
     }
-    else if (c == 'e' || c == 'E') {
-      buf += c;
-      ReadChar(c);
-      if (c == '+' && c == '-' && !isdigit(c)) {
-        throw InvalidFileException(CreateLineMsg("Invalid Token +/-"));
+    if (c == 'e' || c == 'E') {
+      c = ReadChar();
+      if (c == '+' || c == '-') {
+	c = ReadChar();
       }
-      buf += c;
-      ReadChar(c);
-      while (isdigit(c)) {
-        buf += c;
-        ReadChar(c);
+      if (!isdigit(c)) {
+	throw InvalidFileException(CreateLineMsg("Invalid exponent in number"));
       }
-      UnreadChar();
-      m_lastText = buf;
-      return (m_lastToken = TOKEN_NUMBER);
-    }
-    else {
-      UnreadChar();
-      m_lastText = buf;
-      return (m_lastToken = TOKEN_NUMBER);
-    }
-  }
-  else if (c == '.') {
-    std::string buf;
-    buf += c;
-    ReadChar(c);
-
-    while (isdigit(c)) {
-      buf += c;
-      ReadChar(c);
+      c = ReadDigits();
     }
     UnreadChar();
-    m_lastText = buf;
+    m_lastText.assign(start, m_current - start);
     return (m_lastToken = TOKEN_NUMBER);
   }
-
   else if (c == '"') {
     // We need to do a little magic here, since escaped quotes inside
     // the string are treated as quotes (not end-of-string)
-    UnreadChar();
-    char a;
+    m_lastText.clear();
+    bool lastslash = false;
 
-    m_lastText = "";
-
-    do  {
-      ReadChar(a);
-      if (a == '\n') {
-        IncreaseLine();
+    char a = ReadChar();
+    while (a != '\"' || lastslash) {
+      if (a == '\0' && m_current > m_end) {
+	throw InvalidFileException(CreateLineMsg("End of file encountered when reading string label"));
       }
-    } while (isspace(a));
-
-    if (a == '\"')  {
-      bool lastslash = false;
-
-      ReadChar(a);
-      while  (a != '\"' || lastslash)  {
-	if (m_file.eof() || !m_file.good())  {
-	  throw InvalidFileException(CreateLineMsg("End of file encountered when reading string label"));
-	}
-        if (lastslash && a == '"') {
-          m_lastText += '"';
-	}
-        else if (lastslash)  {
-          m_lastText += '\\';
-          m_lastText += a;
-        }
-        else if (a != '\\')
-          m_lastText += a;
-
-        lastslash = (a == '\\');
-        ReadChar(a);
+      else if (a == '\n') {
+	IncreaseLine();
       }
-    }
-    else  {
-      do  {
-      	m_lastText += a;
-        ReadChar(a);
-	if (m_file.eof() || !m_file.good())  {
-	  throw InvalidFileException(CreateLineMsg("End of file encountered when reading string label"));
+      if (lastslash && a == '"') {
+	m_lastText += '"';
+      }
+      else if (lastslash) {
+	m_lastText += '\\';
+	m_lastText += a;
+      }
+      else if (a != '\\') {
+	// Copy the run of ordinary characters in one step
+	const char *run = m_current - 1;
+	while (m_current < m_end && *m_current != '"' && 
+	       *m_current != '\\' && *m_current != '\n') {
+	  m_current++;
 	}
-        if (a == '\n') {
-          IncreaseLine();
-        }
-      }  while (!isspace(a));
+	m_currentColumn += m_current - run - 1;
+	m_lastText.append(run, m_current - run);
+      }
+
+      lastslash = (a == '\\');
+      a = ReadChar();
     }
 
     return (m_lastToken = TOKEN_TEXT);
   }
 
-  m_lastText = "";
-  while (!isspace(c) && !m_file.eof()) {
-    m_lastText += c;
-    ReadChar(c);
+  while (c != '\0' && !isspace(c)) {
+    c = ReadChar();
   }
+  m_lastText.assign(start, m_current - start - 1);
   return (m_lastToken = TOKEN_SYMBOL);
 }
 
@@ -603,21 +536,32 @@ void ParseOutcomeBody(GameParserState &p_parser, GameRep *p_nfg)
   }
 }
 
+//
+// In a newly-created table, each contingency has its own outcome, and the
+// outcomes are numbered in the same order as the contingencies appear in
+// the file (player 1's strategy changing fastest), so payoffs can be
+// written to the outcomes directly.
+//
 void ParsePayoffBody(GameParserState &p_parser, GameRep *p_nfg)
 {
-  StrategyProfileIterator iter(StrategySupportProfile(static_cast<GameRep *>(p_nfg)));
-  int pl = 1;
+  int numPlayers = p_nfg->NumPlayers();
+  int cont = 1, pl = 1;
+  GameOutcomeRep *outcome = 0;
 
   while (p_parser.GetCurrentToken() != TOKEN_EOF) {
-    if (p_parser.GetCurrentToken() == TOKEN_NUMBER) {
-      (*iter)->GetOutcome()->SetPayoff(pl, p_parser.GetLastText());
-    }
-    else {
+    if (p_parser.GetCurrentToken() != TOKEN_NUMBER) {
       throw InvalidFileException(p_parser.CreateLineMsg("Expecting payoff"));
     }
+    if (pl == 1) {
+      if (cont > p_nfg->NumOutcomes()) {
+	throw InvalidFileException(p_parser.CreateLineMsg("Too many payoffs"));
+      }
+      outcome = p_nfg->GetOutcome(cont);
+    }
+    outcome->SetPayoff(pl, p_parser.GetLastText());
 
-    if (++pl > p_nfg->NumPlayers()) {
-      iter++;
+    if (++pl > numPlayers) {
+      cont++;
       pl = 1;
     }
     p_parser.GetNextToken();
@@ -1053,17 +997,38 @@ Game GameXMLSavefile::GetGame(void) const
 
 Game ReadGame(std::istream &p_file) throw (InvalidFileException)
 {
-  std::stringstream buffer;
-  buffer << p_file.rdbuf();
-  try {
-    GameXMLSavefile doc(buffer.str());
-    return doc.GetGame();
+  // Read the whole file into memory once; all parsing works on this buffer
+  std::string buffer;
+  char chunk[65536];
+  while (p_file.read(chunk, sizeof(chunk)) || p_file.gcount() > 0) {
+    buffer.append(chunk, p_file.gcount());
+  }
+
+  const char *begin = buffer.data(), *end = buffer.data() + buffer.length();
+  if (IsBinaryGameFile(begin, end)) {
+    try {
+      BinaryFileReader reader(begin, end);
+      Game game = ((reader.ReadHeader() == BINARY_GAME_TABLE) ?
+		   GameTableRep::ReadBinaryFile(reader) :
+		   GameTreeRep::ReadBinaryFile(reader));
+      if (!reader.AtEnd()) {
+	throw InvalidFileException("Unexpected data after end of binary game file");
+      }
+      return game;
+    }
+    catch (std::exception &ex) {
+      throw InvalidFileException(ex.what());
+    }
   }
-  catch (InvalidFileException) {
-    buffer.seekg(0, std::ios::beg);
+
+  // XML documents are recognized by their first non-blank character
+  std::string::size_type first = buffer.find_first_not_of(" \t\r\n");
+  if (first != std::string::npos && buffer[first] == '<') {
+    GameXMLSavefile doc(buffer);
+    return doc.GetGame();
   }
 
-  GameParserState parser(buffer);
+  GameParserState parser(begin, end);
   try {
     if (parser.GetNextToken() != TOKEN_SYMBOL) {
       throw InvalidFileException(parser.CreateLineMsg("Expecting file type"));
@@ -1077,16 +1042,19 @@ Game ReadGame(std::istream &p_file) throw (InvalidFileException)
     else if (parser.GetLastText() == "EFG") {
       TreeData treeData;
       Game game = NewTree();
-      dynamic_cast<GameTreeRep &>(*game).SetCanonicalization(false);
-      ParseEfg(parser, game, treeData);
-      dynamic_cast<GameTreeRep &>(*game).SetCanonicalization(true);
+      {
+	DeferredCanonicalization deferred(game);
+	ParseEfg(parser, game, treeData);
+      }
       return game;
     }
     else if (parser.GetLastText() == "#AGG") {
-      return GameAggRep::ReadAggFile(buffer);
+      std::istringstream rest(buffer.substr(parser.GetPosition() - buffer.data()));
+      return GameAggRep::ReadAggFile(rest);
     }
     else if (parser.GetLastText() == "#BAGG") {
-      return GameBagentRep::ReadBaggFile(buffer);
+      std::istringstream rest(buffer.substr(parser.GetPosition() - buffer.data()));
+      return GameBagentRep::ReadBaggFile(rest);
     }
     else {
       throw InvalidFileException("Tokens 'EFG' or 'NFG' or '#AGG' or '#BAGG' expected at start of file");
@@ -22,6 +22,7 @@
 
 #include <iostream>
 #include <sstream>
+#include <climits>
 
 #include "gambit/gambit.h"
 #include "gambit/gametree.h"
@@ -33,11 +34,19 @@ namespace Gambit {
 //                       class GameOutcomeRep
 //========================================================================
 
-GameOutcomeRep::GameOutcomeRep(GameRep *p_game, int p_number)
+GameOutcomeRep::GameOutcomeRep(GameRep *p_game, PayoffTable *p_payoffs,
+			       int p_number)
   : m_game(p_game), m_number(p_number),
-    m_payoffs(m_game->NumPlayers()), m_unrestricted(0)
+    m_payoffs(p_payoffs), m_unrestricted(0)
 { }
 
+void GameOutcomeRep::SetPayoff(int pl, const std::string &p_value)
+{
+  m_game->CheckMutable();
+  if (pl < 1 || pl > m_payoffs->NumPlayers())  throw IndexException();
+  m_payoffs->SetPayoff(m_number, pl, p_value);
+}
+
 
 //========================================================================
 //                      class GameStrategyRep
@@ -46,6 +55,7 @@ GameOutcomeRep::GameOutcomeRep(GameRep *p_game, int p_number)
 void GameStrategyRep::DeleteStrategy(void)
 {
   if (m_player->GetGame()->IsTree())  throw UndefinedException();
+  m_player->m_game->CheckMutable();
   if (m_player->NumStrategies() == 1)  return;
 
   m_player->m_strategies.Remove(m_player->m_strategies.Find(this));
@@ -79,6 +89,7 @@ GamePlayerRep::~GamePlayerRep()
 GameStrategy GamePlayerRep::NewStrategy(void)
 {
   if (m_game->IsTree())  throw UndefinedException();
+  m_game->CheckMutable();
 
   GameStrategyRep *strategy = new GameStrategyRep(this);
   m_strategies.Append(strategy);
@@ -196,17 +207,21 @@ PureStrategyProfileRep::PureStrategyProfileRep(const Game &p_game)
   }
 }
 
+Array<Rational>
+PureStrategyProfileRep::GetStrategyValues(const GamePlayer &p_player) const
+{
+  Array<Rational> values(p_player->NumStrategies());
+  for (int st = 1; st <= values.Length(); st++) {
+    values[st] = GetStrategyValue(p_player->GetStrategy(st));
+  }
+  return values;
+}
+
 bool PureStrategyProfileRep::IsNash(void) const
 {
   for (int pl = 1; pl <= m_nfg->NumPlayers(); pl++) {
-    GamePlayer player = m_nfg->GetPlayer(pl);
-    Rational current = GetPayoff(player);
-    for (GameStrategyArray::const_iterator strategy = player->Strategies().begin();
-	 strategy != player->Strategies().end();
-	 ++strategy)  {
-      if (GetStrategyValue(*strategy) > current) {
-        return false;
-      }
+    if (!IsBestResponse(m_nfg->GetPlayer(pl))) {
+      return false;
     }
   }
   return true;
@@ -217,10 +232,9 @@ bool PureStrategyProfileRep::IsStrictNash(void) const
   for (int pl = 1; pl <= m_nfg->NumPlayers(); pl++) {
     GamePlayer player = m_nfg->GetPlayer(pl);
     Rational current = GetPayoff(player);
-    for (GameStrategyArray::const_iterator strategy = player->Strategies().begin();
-	 strategy != player->Strategies().end();
-	 ++strategy) {
-      if (GetStrategyValue(*strategy) >= current) {
+    Array<Rational> values = GetStrategyValues(player);
+    for (int st = 1; st <= values.Length(); st++) {
+      if (values[st] >= current) {
         return false;
       }
     }
@@ -231,10 +245,9 @@ bool PureStrategyProfileRep::IsStrictNash(void) const
 bool PureStrategyProfileRep::IsBestResponse(const GamePlayer &p_player) const
 {
   Rational current = GetPayoff(p_player);
-  for (GameStrategyArray::const_iterator strategy = p_player->Strategies().begin();
-       strategy != p_player->Strategies().end();
-       ++strategy) {
-    if (GetStrategyValue(*strategy) > current) {
+  Array<Rational> values = GetStrategyValues(p_player);
+  for (int st = 1; st <= values.Length(); st++) {
+    if (values[st] > current) {
       return false;
     }
   }
@@ -244,18 +257,17 @@ bool PureStrategyProfileRep::IsBestResponse(const GamePlayer &p_player) const
 List<GameStrategy> 
 PureStrategyProfileRep::GetBestResponse(const GamePlayer &p_player) const
 {
-  GameStrategyArray::const_iterator strategy = p_player->Strategies().begin();
-  Rational max_payoff = GetStrategyValue(*strategy);
+  Array<Rational> values = GetStrategyValues(p_player);
+  Rational max_payoff = values[1];
   List<GameStrategy> br;
-  br.push_back(*strategy);
-  for (++strategy; strategy != p_player->Strategies().end(); ++strategy)  {
-    Rational this_payoff = GetStrategyValue(*strategy);
-    if (this_payoff > max_payoff) {
+  br.push_back(p_player->GetStrategy(1));
+  for (int st = 2; st <= values.Length(); st++) {
+    if (values[st] > max_payoff) {
       br.clear();
-      max_payoff = this_payoff;
+      max_payoff = values[st];
     }
-    if (this_payoff >= max_payoff) {
-      br.push_back(*strategy);
+    if (values[st] >= max_payoff) {
+      br.push_back(p_player->GetStrategy(st));
     }
   }
   return br;
@@ -400,6 +412,20 @@ PureBehaviorProfile::ToMixedBehaviorProfile(void) const
 //                            class GameRep
 //========================================================================
 
+//------------------------------------------------------------------------
+//                         GameRep: Lifecycle
+//------------------------------------------------------------------------
+
+Game GameRep::Freeze(void) const
+{
+  if (m_frozen)  return const_cast<GameRep *>(this);
+
+  Game game = Copy();
+  game->MakeShared();
+  game->m_frozen = true;
+  return game;
+}
+
 //------------------------------------------------------------------------
 //                     GameRep: Writing data files
 //------------------------------------------------------------------------
@@ -478,6 +504,20 @@ GameExplicitRep::~GameExplicitRep()
        m_outcomes[outc++]->Invalidate());
 }
 
+void GameExplicitRep::MakeShared(void)
+{
+  BuildComputedValues();
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    GamePlayerRep *player = m_players[pl];
+    for (int st = 1; st <= player->m_strategies.Length(); 
+	 player->m_strategies[st++]->Share());
+    player->Share();
+  }
+  for (int outc = 1; outc <= m_outcomes.Length(); 
+       m_outcomes[outc++]->Share());
+  Share();
+}
+
 //------------------------------------------------------------------------
 //                  GameExplicitRep: General data access
 //------------------------------------------------------------------------
@@ -557,12 +597,16 @@ GameStrategy GameExplicitRep::GetStrategy(int p_index) const
   throw IndexException();
 }
 
-int GameExplicitRep::NumStrategyContingencies(void) const
+long GameExplicitRep::NumStrategyContingencies(void) const
 {
   const_cast<GameExplicitRep *>(this)->BuildComputedValues();
-  int ncont = 1;
+  long ncont = 1L;
   for (int pl = 1; pl <= m_players.Length(); pl++) {
-    ncont *= m_players[pl]->m_strategies.Length();
+    long strats = m_players[pl]->m_strategies.Length();
+    if (strats > 0 && ncont > LONG_MAX / strats) {
+      throw RangeException("Number of contingencies exceeds supported range");
+    }
+    ncont *= strats;
   }
   return ncont;
 }
@@ -583,7 +627,10 @@ int GameExplicitRep::MixedProfileLength(void) const
 
 GameOutcome GameExplicitRep::NewOutcome(void)
 {
-  m_outcomes.Append(new GameOutcomeRep(this, m_outcomes.Length() + 1));
+  CheckMutable();
+  m_payoffs.AddOutcome();
+  m_outcomes.Append(new GameOutcomeRep(this, &m_payoffs,
+				       m_outcomes.Length() + 1));
   return m_outcomes[m_outcomes.Last()];
 }
 
@@ -602,6 +649,9 @@ void GameExplicitRep::Write(std::ostream &p_stream,
 	   (p_format == "native" && !IsTree())) {
     WriteNfgFile(p_stream);
   }
+  else if (p_format == "binary") {
+    WriteBinaryFile(p_stream);
+  }
   else {
     throw UndefinedException();
   }
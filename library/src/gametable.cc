@@ -22,9 +22,11 @@
 
 #include <iostream>
 #include <sstream>
+#include <climits>
 
 #include "gambit/gambit.h"
 #include "gambit/gametable.h"
+#include "gambit/binfile.h"
 
 namespace Gambit {
 
@@ -82,17 +84,20 @@ void TablePureStrategyProfileRep::SetStrategy(const GameStrategy &s)
 
 GameOutcome TablePureStrategyProfileRep::GetOutcome(void) const
 { 
-  return dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index]; 
+  return dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index - 1]; 
 }
 
 void TablePureStrategyProfileRep::SetOutcome(GameOutcome p_outcome)
 {
-  dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index] = p_outcome; 
+  m_nfg->CheckMutable();
+  GameTableRep &game = dynamic_cast<GameTableRep &>(*m_nfg);
+  game.m_results[m_index - 1] = p_outcome; 
+  game.ClearComputedValues();
 }
 
 Rational TablePureStrategyProfileRep::GetPayoff(int pl) const
 {
-  GameOutcomeRep *outcome = dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index];
+  GameOutcomeRep *outcome = dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index - 1];
   if (outcome) {
     return outcome->GetPayoff<Rational>(pl);
   }
@@ -105,7 +110,7 @@ Rational
 TablePureStrategyProfileRep::GetStrategyValue(const GameStrategy &p_strategy) const
 {
   int player = p_strategy->GetPlayer()->GetNumber();
-  GameOutcomeRep *outcome = dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index - m_profile[player]->m_offset + p_strategy->m_offset];
+  GameOutcomeRep *outcome = dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index - 1 - m_profile[player]->m_offset + p_strategy->m_offset];
   if (outcome) {
     return outcome->GetPayoff<Rational>(player);
   }
@@ -127,11 +132,16 @@ PureStrategyProfile GameTableRep::NewPureStrategyProfile(void) const
 
 namespace {
 /// This convenience function computes the Cartesian product of the
-/// elements in dim.
-int Product(const Array<int> &dim)
+/// elements in dim, checking that it can be used as a contingency index.
+long Product(const Array<int> &dim)
 {
-  int accum = 1;
-  for (int i = 1; i <= dim.Length(); accum *= dim[i++]);
+  long accum = 1L;
+  for (int i = 1; i <= dim.Length(); i++) {
+    if (dim[i] > 0 && accum > LONG_MAX / dim[i]) {
+      throw RangeException("Number of contingencies exceeds supported range");
+    }
+    accum *= dim[i];
+  }
   return accum;
 }
 
@@ -140,8 +150,19 @@ int Product(const Array<int> &dim)
   
 GameTableRep::GameTableRep(const Array<int> &dim, 
 			   bool p_sparseOutcomes /* = false */)
+  : m_doubleTensorValid(false), m_rationalTensorValid(false),
+    m_doubleRevision(0), m_rationalRevision(0)
 {
-  m_results = Array<GameOutcomeRep *>(Product(dim));
+  long contingencies = Product(dim);
+  // Outcomes are numbered by int, so a table with an outcome in each
+  // contingency is limited to that range; sparse tables are not
+  if (!p_sparseOutcomes && contingencies > INT_MAX) {
+    throw RangeException("Number of contingencies exceeds supported range");
+  }
+  if ((unsigned long) contingencies > m_results.max_size()) {
+    throw RangeException("Number of contingencies exceeds supported range");
+  }
+  m_results.assign(contingencies, 0);
   for (int pl = 1; pl <= dim.Length(); pl++)  {
     m_players.Append(new GamePlayerRep(this, pl, dim[pl]));
     m_players[pl]->m_label = lexical_cast<std::string>(pl);
@@ -152,24 +173,110 @@ GameTableRep::GameTableRep(const Array<int> &dim,
   IndexStrategies();
 
   if (p_sparseOutcomes) {
-    for (int cont = 1; cont <= m_results.Length();
-	 m_results[cont++] = 0);
+    m_payoffs = PayoffTable(dim.Length(), 0);
   }
   else {
-    m_outcomes = Array<GameOutcomeRep *>(m_results.Length());
+    m_outcomes = Array<GameOutcomeRep *>(contingencies);
+    m_payoffs = PayoffTable(dim.Length(), contingencies);
     for (int i = 1; i <= m_outcomes.Length(); i++) {
-      m_outcomes[i] = new GameOutcomeRep(this, i);
+      m_outcomes[i] = new GameOutcomeRep(this, &m_payoffs, i);
+      m_results[i-1] = m_outcomes[i];
     }
-    m_results = m_outcomes;
   }
 }
 
 Game GameTableRep::Copy(void) const
 {
-  std::ostringstream os;
-  WriteNfgFile(os);
-  std::istringstream is(os.str());
-  return ReadGame(is);
+  GameTableRep *game = new GameTableRep(NumStrategies(), true);
+  game->m_title = m_title;
+  game->m_comment = m_comment;
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    GamePlayerRep *player = game->m_players[pl];
+    player->m_label = m_players[pl]->m_label;
+    for (int st = 1; st <= player->m_strategies.Length(); st++) {
+      player->m_strategies[st]->m_label = m_players[pl]->m_strategies[st]->m_label;
+    }
+  }
+
+  game->m_payoffs = m_payoffs;
+  game->m_outcomes = Array<GameOutcomeRep *>(m_outcomes.Length());
+  for (int outc = 1; outc <= m_outcomes.Length(); outc++) {
+    game->m_outcomes[outc] = new GameOutcomeRep(game, &game->m_payoffs, outc);
+    game->m_outcomes[outc]->m_label = m_outcomes[outc]->m_label;
+  }
+
+  for (size_t cont = 0; cont < m_results.size(); cont++) {
+    game->m_results[cont] = ((m_results[cont]) ? 
+			     game->m_outcomes[m_results[cont]->m_number] : 0);
+  }
+  return game;
+}
+
+Game GameTableRep::ReadBinaryFile(BinaryFileReader &p_file)
+{
+  std::string title = p_file.ReadString();
+  std::string comment = p_file.ReadString();
+
+  // Each player takes at least a label and a strategy count
+  int players = p_file.ReadCount(sizeof(uint32_t) + sizeof(uint64_t));
+  Array<int> dim(players);
+  Array<std::string> playerLabels(players);
+  Array<Array<std::string> > strategyLabels(players);
+  uint64_t contingencies = 1;
+  for (int pl = 1; pl <= players; pl++) {
+    playerLabels[pl] = p_file.ReadString();
+    dim[pl] = p_file.ReadCount(sizeof(uint32_t));
+    if (dim[pl] == 0) {
+      throw InvalidFileException("Player with no strategies in binary game file");
+    }
+    // The table of contingencies follows, so its size is bounded by the data
+    contingencies *= dim[pl];
+    if (contingencies > p_file.Remaining() / sizeof(uint32_t)) {
+      throw InvalidFileException("Unexpected end of binary game file");
+    }
+    strategyLabels[pl] = Array<std::string>(dim[pl]);
+    for (int st = 1; st <= dim[pl]; st++) {
+      strategyLabels[pl][st] = p_file.ReadString();
+    }
+  }
+
+  GameTableRep *game = new GameTableRep(dim, true);
+  Game holder(game);
+  game->m_title = title;
+  game->m_comment = comment;
+  for (int pl = 1; pl <= players; pl++) {
+    GamePlayerRep *player = game->m_players[pl];
+    player->m_label = playerLabels[pl];
+    for (int st = 1; st <= dim[pl]; st++) {
+      player->m_strategies[st]->m_label = strategyLabels[pl][st];
+    }
+  }
+
+  int outcomes = p_file.ReadCount(sizeof(uint32_t));
+  game->m_outcomes = Array<GameOutcomeRep *>(outcomes);
+  for (int outc = 1; outc <= outcomes; outc++) {
+    game->m_outcomes[outc] = new GameOutcomeRep(game, &game->m_payoffs, outc);
+    game->m_outcomes[outc]->m_label = p_file.ReadString();
+  }
+  game->m_payoffs.ReadBinary(p_file);
+  if (game->m_payoffs.NumPlayers() != players ||
+      game->m_payoffs.NumOutcomes() != outcomes) {
+    throw InvalidFileException("Mismatched payoff table in binary game file");
+  }
+
+  if (p_file.ReadCount(sizeof(uint32_t)) != contingencies) {
+    throw InvalidFileException("Mismatched number of contingencies in binary game file");
+  }
+  std::vector<uint32_t> results(contingencies);
+  p_file.ReadArray(&results[0], contingencies);
+  for (size_t cont = 0; cont < game->m_results.size(); cont++) {
+    if (results[cont] > (uint32_t) outcomes) {
+      throw InvalidFileException("Invalid outcome in binary game file");
+    }
+    game->m_results[cont] = ((results[cont]) ?
+			     game->m_outcomes[results[cont]] : 0);
+  }
+  return holder;
 }
 
 //------------------------------------------------------------------------
@@ -251,16 +358,11 @@ void GameTableRep::WriteNfgFile(std::ostream &p_file) const
 
   p_file << "\"" << EscapeQuotes(m_comment) << "\"\n\n";
 
-  int ncont = 1;
-  for (int i = 1; i <= NumPlayers(); i++) {
-    ncont *= m_players[i]->m_strategies.Length();
-  }
-
   p_file << "{\n";
   for (int outc = 1; outc <= m_outcomes.Length(); outc++)   {
     p_file << "{ \"" << EscapeQuotes(m_outcomes[outc]->m_label) << "\" ";
     for (int pl = 1; pl <= m_players.Length(); pl++)  {
-      p_file << (const std::string &) m_outcomes[outc]->m_payoffs[pl];
+      p_file << m_payoffs.GetText(outc, pl);
       
       if (pl < m_players.Length()) {
 	p_file << ", ";
@@ -272,7 +374,7 @@ void GameTableRep::WriteNfgFile(std::ostream &p_file) const
   }
   p_file << "}\n";
   
-  for (int cont = 1; cont <= ncont; cont++)  {
+  for (size_t cont = 0; cont < m_results.size(); cont++)  {
     if (m_results[cont] != 0) {
       p_file << m_results[cont]->m_number << ' ';
     }
@@ -284,18 +386,47 @@ void GameTableRep::WriteNfgFile(std::ostream &p_file) const
   p_file << '\n';
 }
 
+void GameTableRep::WriteBinaryFile(std::ostream &p_file) const
+{
+  BinaryFileWriter file(p_file);
+  file.WriteHeader(BINARY_GAME_TABLE);
+  file.WriteString(m_title);
+  file.WriteString(m_comment);
+  file.WriteCount(m_players.Length());
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    GamePlayerRep *player = m_players[pl];
+    file.WriteString(player->m_label);
+    file.WriteCount(player->m_strategies.Length());
+    for (int st = 1; st <= player->m_strategies.Length(); st++) {
+      file.WriteString(player->m_strategies[st]->m_label);
+    }
+  }
+
+  file.WriteCount(m_outcomes.Length());
+  for (int outc = 1; outc <= m_outcomes.Length(); outc++) {
+    file.WriteString(m_outcomes[outc]->m_label);
+  }
+  m_payoffs.WriteBinary(file);
+
+  std::vector<uint32_t> results(m_results.size());
+  for (size_t cont = 0; cont < m_results.size(); cont++) {
+    results[cont] = (m_results[cont]) ? m_results[cont]->m_number : 0;
+  }
+  file.WriteCount(results.size());
+  file.WriteArray(&results[0], results.size());
+}
+
 //------------------------------------------------------------------------
 //                       GameTableRep: Players
 //------------------------------------------------------------------------
 
 GamePlayer GameTableRep::NewPlayer(void)
 {
+  CheckMutable();
   GamePlayerRep *player = 0;
   player = new GamePlayerRep(this, m_players.Length() + 1, 1);
   m_players.Append(player);
-  for (int outc = 1; outc <= m_outcomes.Last(); outc++) {
-    m_outcomes[outc]->m_payoffs.Append(Number());
-  }
+  m_payoffs.AddPlayer();
   ClearComputedValues();
   return player;
 }
@@ -306,11 +437,13 @@ GamePlayer GameTableRep::NewPlayer(void)
 
 void GameTableRep::DeleteOutcome(const GameOutcome &p_outcome)
 {
-  for (int i = 1; i <= m_results.Length(); i++) {
-    if (m_results[i] == p_outcome) {
-      m_results[i] = 0;
+  CheckMutable();
+  for (size_t cont = 0; cont < m_results.size(); cont++) {
+    if (m_results[cont] == p_outcome) {
+      m_results[cont] = 0;
     }
   }
+  m_payoffs.RemoveOutcome(p_outcome->GetNumber());
   m_outcomes.Remove(m_outcomes.Find(p_outcome))->Invalidate();
   for (int outc = 1; outc <= m_outcomes.Length(); outc++) {
     m_outcomes[outc]->m_number = outc;
@@ -357,8 +490,7 @@ void GameTableRep::RebuildTable(void)
     size *= m_players[pl]->NumStrategies();
   }
 
-  Array<GameOutcomeRep *> newResults(size);
-  for (int i = 1; i <= newResults.Length(); newResults[i++] = 0);
+  std::vector<GameOutcomeRep *> newResults(NumStrategyContingencies(), 0);
 
   for (StrategyProfileIterator iter(StrategySupportProfile(const_cast<GameTableRep *>(this)));
        !iter.AtEnd(); iter++) {
@@ -375,13 +507,14 @@ void GameTableRep::RebuildTable(void)
     }
 
     if (newindex >= 1) {
-      newResults[newindex] = m_results[iter.m_profile->GetIndex()];
+      newResults[newindex - 1] = m_results[iter.m_profile->GetIndex() - 1];
     }
   }
 
-  m_results = newResults;
+  m_results.swap(newResults);
 
   IndexStrategies();
+  ClearComputedValues();
 }
 
 void GameTableRep::IndexStrategies(void)
@@ -408,5 +541,68 @@ void GameTableRep::IndexStrategies(void)
   }
 }
 
+//------------------------------------------------------------------------
+//                      GameTableRep: Payoff tensor
+//------------------------------------------------------------------------
+
+void GameTableRep::ClearComputedValues(void) const
+{
+  m_doubleTensorValid = false;
+  m_rationalTensorValid = false;
+}
+
+namespace {
+
+/// Fills in p_tensor with the payoffs to each player in each contingency
+/// of the table p_results.
+template <class T>
+void BuildPayoffTensor(const std::vector<GameOutcomeRep *> &p_results,
+		       int p_players, std::vector<std::vector<T> > &p_tensor)
+{
+  p_tensor.assign(p_players, std::vector<T>(p_results.size(), T(0)));
+  for (size_t cont = 0; cont < p_results.size(); cont++) {
+    GameOutcomeRep *outcome = p_results[cont];
+    if (outcome) {
+      for (int pl = 1; pl <= p_players; pl++) {
+	p_tensor[pl-1][cont] = outcome->GetPayoff<T>(pl);
+      }
+    }
+  }
+}
+
+} // end anonymous namespace
+
+template<> const double *GameTableRep::GetPayoffTensor(int pl) const
+{
+  if (pl < 1 || pl > m_players.Length())  throw IndexException();
+  if (!m_doubleTensorValid || m_doubleRevision != m_payoffs.GetRevision()) {
+    BuildPayoffTensor(m_results, m_players.Length(), m_doubleTensor);
+    m_doubleTensorValid = true;
+    m_doubleRevision = m_payoffs.GetRevision();
+  }
+  return &m_doubleTensor[pl-1][0];
+}
+
+template<> const Rational *GameTableRep::GetPayoffTensor(int pl) const
+{
+  if (pl < 1 || pl > m_players.Length())  throw IndexException();
+  if (!m_rationalTensorValid || 
+      m_rationalRevision != m_payoffs.GetRevision()) {
+    BuildPayoffTensor(m_results, m_players.Length(), m_rationalTensor);
+    m_rationalTensorValid = true;
+    m_rationalRevision = m_payoffs.GetRevision();
+  }
+  return &m_rationalTensor[pl-1][0];
+}
+
+void GameTableRep::MakeShared(void)
+{
+  GameExplicitRep::MakeShared();
+  if (m_players.Length() > 0) {
+    // Building the tensor for one player builds those of all players
+    GetPayoffTensor<double>(1);
+    GetPayoffTensor<Rational>(1);
+  }
+}
 
 }  // end namespace Gambit
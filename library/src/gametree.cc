@@ -20,11 +20,13 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 
 #include "gambit/gambit.h"
 #include "gambit/gametree.h"
+#include "gambit/binfile.h"
 
 namespace Gambit {
 
@@ -49,6 +51,7 @@ bool GameTreeActionRep::Precedes(const GameNode &n) const
 
 void GameTreeActionRep::DeleteAction(void)
 {
+  m_infoset->m_efg->CheckMutable();
   if (m_infoset->NumActions() == 1) throw UndefinedException();
 
   int where;
@@ -103,6 +106,7 @@ Game GameTreeInfosetRep::GetGame(void) const { return m_efg; }
 
 void GameTreeInfosetRep::SetPlayer(GamePlayer p_player)
 {
+  m_efg->CheckMutable();
   if (p_player->GetGame() != m_efg) throw MismatchException();
   if (m_player->IsChance() || p_player->IsChance()) throw UndefinedException();
   if (m_player == p_player) return;
@@ -131,6 +135,7 @@ bool GameTreeInfosetRep::Precedes(GameNode p_node) const
 
 GameAction GameTreeInfosetRep::InsertAction(GameAction p_action /* =0 */)
 {
+  m_efg->CheckMutable();
   if (p_action && p_action->GetInfoset() != this) throw MismatchException();
   
   int where = m_actions.Length() + 1;
@@ -172,6 +177,7 @@ void GameTreeInfosetRep::RemoveAction(int which)
 
 void GameTreeInfosetRep::SetActionProb(int act, const std::string &p_value)
 {
+  m_efg->CheckMutable();
   m_probs[act] = p_value;
   m_efg->ClearComputedValues();
 }
@@ -190,6 +196,7 @@ void GameTreeInfosetRep::RemoveMember(GameTreeNodeRep *p_node)
 
 void GameTreeInfosetRep::Reveal(GamePlayer p_player)
 {
+  m_efg->CheckMutable();
   for (int act = 1; act <= m_actions.Length(); act++) {
     GameActionRep *action = m_actions[act];
     for (int iset = 1; iset <= p_player->m_infosets.Length(); iset++) {
@@ -287,6 +294,7 @@ void GameTreeNodeRep::DeleteOutcome(GameOutcomeRep *outc)
 
 void GameTreeNodeRep::SetOutcome(const GameOutcome &p_outcome)
 {
+  m_efg->CheckMutable();
   if (p_outcome != outcome) {
     outcome = p_outcome;
     m_efg->ClearComputedValues();
@@ -302,34 +310,15 @@ bool GameTreeNodeRep::IsSuccessorOf(GameNode p_node) const
 
 bool GameTreeNodeRep::IsSubgameRoot(void) const
 {
-  // First take care of a couple easy cases
-  if (children.Length() == 0 || infoset->NumMembers() > 1) return false;
-  if (!m_parent) return true;
-
-  // A node is a subgame root if and only if in every information set,
-  // either all members succeed the node in the tree,
-  // or all members do not succeed the node in the tree.
-  for (int pl = 1; pl <= m_efg->NumPlayers(); pl++) {
-    GamePlayerRep *player = m_efg->GetPlayer(pl);
-    
-    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
-      GameTreeInfosetRep *infoset = dynamic_cast<GameTreeInfosetRep *>(player->GetInfoset(iset).operator->());
-
-      bool precedes = infoset->GetMember(1)->IsSuccessorOf(const_cast<GameTreeNodeRep *>(this));
-
-      for (int mem = 2; mem <= infoset->NumMembers(); mem++) {
-	if (infoset->GetMember(mem)->IsSuccessorOf(const_cast<GameTreeNodeRep *>(this)) != precedes) {
-	  return false;
-	}
-      }
-    }
-  }
-
-  return true;
+  // The roots of subgames are found when the tree is compiled, and are
+  // kept until the tree is next changed.  Nodes are numbered in preorder,
+  // as are the positions in the compiled tree.
+  return m_efg->GetCompiledTree().IsSubgameRoot(number);
 }
 
 void GameTreeNodeRep::DeleteParent(void)
 {
+  m_efg->CheckMutable();
   if (!m_parent) return;
   GameTreeNodeRep *oldParent = m_parent;
 
@@ -350,6 +339,7 @@ void GameTreeNodeRep::DeleteParent(void)
 
 void GameTreeNodeRep::DeleteTree(void)
 {
+  m_efg->CheckMutable();
   while (children.Length() > 0) {
     children[1]->DeleteTree();
     children[1]->Invalidate();
@@ -387,6 +377,7 @@ void GameTreeNodeRep::CopySubtree(GameTreeNodeRep *src, GameTreeNodeRep *stop)
 
 void GameTreeNodeRep::CopyTree(GameNode p_src)
 {
+  m_efg->CheckMutable();
   if (p_src->GetGame() != m_efg) throw MismatchException();
   if (p_src == this || children.Length() > 0) return;
 
@@ -405,6 +396,7 @@ void GameTreeNodeRep::CopyTree(GameNode p_src)
 
 void GameTreeNodeRep::MoveTree(GameNode p_src)
 {
+  m_efg->CheckMutable();
   if (p_src->GetGame() != m_efg) throw MismatchException();
   if (p_src == this || children.Length() > 0 || IsSuccessorOf(p_src)) {
     return;
@@ -435,14 +427,26 @@ void GameTreeNodeRep::MoveTree(GameNode p_src)
 
 Game GameTreeNodeRep::CopySubgame(void) const
 {
-  std::ostringstream os;
-  m_efg->WriteEfgFile(os, const_cast<GameTreeNodeRep *>(this));
-  std::istringstream is(os.str());
-  return ReadGame(is);
+  GameTreeRep *game = m_efg->CopyPlayers();
+
+  // Information sets and outcomes are created, and numbered, in the order
+  // in which they are first reached in the subtree
+  std::vector<std::vector<GameTreeInfosetRep *> > infosets(m_efg->NumPlayers() + 1);
+  for (int pl = 0; pl <= m_efg->NumPlayers(); pl++) {
+    GamePlayerRep *player = (pl) ? m_efg->m_players[pl] : m_efg->m_chance;
+    infosets[pl].resize(player->m_infosets.Length(), 0);
+  }
+  std::vector<GameOutcomeRep *> outcomes(m_efg->NumOutcomes(), 0);
+  game->CopySubtree(this, game->m_root, infosets, outcomes);
+
+  int index = 1;
+  game->NumberNodes(game->m_root, index);
+  return game;
 }
 
 void GameTreeNodeRep::SetInfoset(GameInfoset p_infoset)
 {
+  m_efg->CheckMutable();
   if (p_infoset->GetGame() != m_efg) throw MismatchException();
   if (!infoset || infoset == p_infoset) return;
   if (p_infoset->NumActions() != children.Length()) 
@@ -458,6 +462,7 @@ void GameTreeNodeRep::SetInfoset(GameInfoset p_infoset)
 
 GameInfoset GameTreeNodeRep::LeaveInfoset(void)
 {
+  m_efg->CheckMutable();
   if (!infoset) return 0;
 
   GameTreeInfosetRep *oldInfoset = infoset;
@@ -479,6 +484,7 @@ GameInfoset GameTreeNodeRep::LeaveInfoset(void)
 
 GameInfoset GameTreeNodeRep::AppendMove(GamePlayer p_player, int p_actions)
 {
+  m_efg->CheckMutable();
   if (p_actions <= 0 || children.Length() > 0) throw UndefinedException();
   if (p_player->GetGame() != m_efg) throw MismatchException();
 
@@ -489,6 +495,7 @@ GameInfoset GameTreeNodeRep::AppendMove(GamePlayer p_player, int p_actions)
 
 GameInfoset GameTreeNodeRep::AppendMove(GameInfoset p_infoset)
 {
+  m_efg->CheckMutable();
   if (children.Length() > 0) throw UndefinedException();
   if (p_infoset->GetGame() != m_efg) throw MismatchException();
   
@@ -505,6 +512,7 @@ GameInfoset GameTreeNodeRep::AppendMove(GameInfoset p_infoset)
   
 GameInfoset GameTreeNodeRep::InsertMove(GamePlayer p_player, int p_actions)
 {
+  m_efg->CheckMutable();
   if (p_actions <= 0) throw UndefinedException();
   if (p_player->GetGame() != m_efg) throw MismatchException();
 
@@ -515,6 +523,7 @@ GameInfoset GameTreeNodeRep::InsertMove(GamePlayer p_player, int p_actions)
 
 GameInfoset GameTreeNodeRep::InsertMove(GameInfoset p_infoset)
 {
+  m_efg->CheckMutable();
   if (p_infoset->GetGame() != m_efg) throw MismatchException();
 
   GameTreeNodeRep *newNode = new GameTreeNodeRep(m_efg, m_parent);
@@ -550,7 +559,7 @@ GameInfoset GameTreeNodeRep::InsertMove(GameInfoset p_infoset)
 //------------------------------------------------------------------------
 
 GameTreeRep::GameTreeRep(void)
-  : m_computedValues(false), m_doCanon(true)
+  : m_computedValues(false), m_doCanon(true), m_compiled(0)
 {
   m_chance = new GamePlayerRep(this, 0);
   m_root = new GameTreeNodeRep(this, 0);
@@ -558,16 +567,186 @@ GameTreeRep::GameTreeRep(void)
 
 GameTreeRep::~GameTreeRep()
 {
+  delete m_compiled;
   m_root->Invalidate();
   m_chance->Invalidate();
 }
 
 Game GameTreeRep::Copy(void) const
 {
-  std::ostringstream os;
-  WriteEfgFile(os);
-  std::istringstream is(os.str());
-  return ReadGame(is);
+  GameTreeRep *game = CopyPlayers();
+
+  game->m_payoffs = m_payoffs;
+  game->m_outcomes = Array<GameOutcomeRep *>(m_outcomes.Length());
+  std::vector<GameOutcomeRep *> outcomes(m_outcomes.Length());
+  for (int outc = 1; outc <= m_outcomes.Length(); outc++) {
+    game->m_outcomes[outc] = new GameOutcomeRep(game, &game->m_payoffs, outc);
+    game->m_outcomes[outc]->m_label = m_outcomes[outc]->m_label;
+    outcomes[outc-1] = game->m_outcomes[outc];
+  }
+
+  // Information sets are created in the same order as in this game,
+  // so they keep their numbers
+  std::vector<std::vector<GameTreeInfosetRep *> > infosets(m_players.Length() + 1);
+  for (int pl = 0; pl <= m_players.Length(); pl++) {
+    GamePlayerRep *player = (pl) ? m_players[pl] : m_chance;
+    for (int iset = 1; iset <= player->m_infosets.Length(); iset++) {
+      infosets[pl].push_back(game->CopyInfoset(player->m_infosets[iset]));
+    }
+  }
+
+  game->CopySubtree(m_root, game->m_root, infosets, outcomes);
+  return game;
+}
+
+Game GameTreeRep::ReadBinaryFile(BinaryFileReader &p_file)
+{
+  GameTreeRep *game = new GameTreeRep();
+  Game holder(game);
+  game->m_title = p_file.ReadString();
+  game->m_comment = p_file.ReadString();
+  int players = p_file.ReadCount(sizeof(uint32_t));
+  for (int pl = 1; pl <= players; pl++) {
+    game->NewPlayer()->SetLabel(p_file.ReadString());
+  }
+
+  int outcomes = p_file.ReadCount(sizeof(uint32_t));
+  game->m_outcomes = Array<GameOutcomeRep *>(outcomes);
+  for (int outc = 1; outc <= outcomes; outc++) {
+    game->m_outcomes[outc] = new GameOutcomeRep(game, &game->m_payoffs, outc);
+    game->m_outcomes[outc]->m_label = p_file.ReadString();
+  }
+  game->m_payoffs.ReadBinary(p_file);
+  if (game->m_payoffs.NumPlayers() != players ||
+      game->m_payoffs.NumOutcomes() != outcomes) {
+    throw InvalidFileException("Mismatched payoff table in binary game file");
+  }
+
+  // Information sets are listed by player, chance first, in order
+  for (int pl = 0; pl <= players; pl++) {
+    GamePlayerRep *player = (pl) ? game->m_players[pl] : game->m_chance;
+    int infosets = p_file.ReadCount(sizeof(uint32_t) + sizeof(uint64_t));
+    for (int iset = 1; iset <= infosets; iset++) {
+      std::string label = p_file.ReadString();
+      int actions = p_file.ReadCount(sizeof(uint32_t));
+      if (actions == 0) {
+	throw InvalidFileException("Information set with no actions in binary game file");
+      }
+      GameTreeInfosetRep *infoset = 
+	new GameTreeInfosetRep(game, iset, player, actions);
+      infoset->m_label = label;
+      for (int act = 1; act <= actions; act++) {
+	infoset->m_actions[act]->m_label = p_file.ReadString();
+	if (player->IsChance()) {
+	  try {
+	    infoset->m_probs[act] = p_file.ReadString();
+	  }
+	  catch (ValueException &) {
+	    throw InvalidFileException("Invalid action probability in binary game file");
+	  }
+	}
+      }
+    }
+  }
+
+  game->ReadBinaryNode(p_file, game->m_root);
+  return holder;
+}
+
+GameTreeRep *GameTreeRep::CopyPlayers(void) const
+{
+  GameTreeRep *game = new GameTreeRep();
+  game->m_title = m_title;
+  game->m_comment = m_comment;
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    game->NewPlayer()->SetLabel(m_players[pl]->m_label);
+  }
+  return game;
+}
+
+GameTreeInfosetRep *GameTreeRep::CopyInfoset(const GameTreeInfosetRep *p_infoset)
+{
+  GamePlayerRep *player = ((p_infoset->m_player->IsChance()) ? 
+			   m_chance : m_players[p_infoset->m_player->m_number]);
+  GameTreeInfosetRep *infoset = 
+    new GameTreeInfosetRep(this, player->m_infosets.Length() + 1, player,
+			   p_infoset->m_actions.Length());
+  infoset->m_label = p_infoset->m_label;
+  for (int act = 1; act <= p_infoset->m_actions.Length(); act++) {
+    infoset->m_actions[act]->m_label = p_infoset->m_actions[act]->m_label;
+  }
+  infoset->m_probs = p_infoset->m_probs;
+  return infoset;
+}
+
+void GameTreeRep::CopySubtree(const GameTreeNodeRep *p_src, 
+			      GameTreeNodeRep *p_dest,
+			      std::vector<std::vector<GameTreeInfosetRep *> > &p_infosets,
+			      std::vector<GameOutcomeRep *> &p_outcomes)
+{
+  p_dest->number = p_src->number;
+  p_dest->m_label = p_src->m_label;
+
+  if (p_src->outcome) {
+    GameOutcomeRep *&outcome = p_outcomes[p_src->outcome->m_number - 1];
+    if (!outcome) {
+      outcome = NewOutcome();
+      outcome->m_label = p_src->outcome->m_label;
+      m_payoffs.CopyOutcome(outcome->m_number, 
+			    *p_src->outcome->m_payoffs, p_src->outcome->m_number);
+    }
+    p_dest->outcome = outcome;
+  }
+
+  if (p_src->infoset) {
+    GamePlayerRep *player = p_src->infoset->m_player;
+    GameTreeInfosetRep *&infoset = 
+      p_infosets[player->m_number][p_src->infoset->m_number - 1];
+    if (!infoset) {
+      infoset = CopyInfoset(p_src->infoset);
+    }
+    p_dest->infoset = infoset;
+    infoset->AddMember(p_dest);
+  }
+
+  p_dest->children = Array<GameTreeNodeRep *>(p_src->children.Length());
+  for (int i = 1; i <= p_src->children.Length(); i++) {
+    p_dest->children[i] = new GameTreeNodeRep(this, p_dest);
+    CopySubtree(p_src->children[i], p_dest->children[i], 
+		p_infosets, p_outcomes);
+  }
+}
+
+void GameTreeRep::ReadBinaryNode(BinaryFileReader &p_file,
+				 GameTreeNodeRep *p_node)
+{
+  p_node->number = p_file.Read<uint32_t>();
+  p_node->m_label = p_file.ReadString();
+  uint32_t outcome = p_file.Read<uint32_t>();
+  if (outcome > (uint32_t) m_outcomes.Length()) {
+    throw InvalidFileException("Invalid outcome in binary game file");
+  }
+  p_node->outcome = (outcome) ? m_outcomes[outcome] : 0;
+
+  // Terminal nodes are marked with a negative player number
+  int32_t pl = p_file.Read<int32_t>();
+  if (pl < 0)  return;
+  uint32_t iset = p_file.Read<uint32_t>();
+  if (pl > m_players.Length()) {
+    throw InvalidFileException("Invalid player in binary game file");
+  }
+  GamePlayerRep *player = (pl) ? m_players[pl] : m_chance;
+  if (iset < 1 || iset > (uint32_t) player->m_infosets.Length()) {
+    throw InvalidFileException("Invalid information set in binary game file");
+  }
+  p_node->infoset = player->m_infosets[iset];
+  p_node->infoset->AddMember(p_node);
+
+  p_node->children = Array<GameTreeNodeRep *>(p_node->infoset->m_actions.Length());
+  for (int i = 1; i <= p_node->children.Length(); i++) {
+    p_node->children[i] = new GameTreeNodeRep(this, p_node);
+    ReadBinaryNode(p_file, p_node->children[i]);
+  }
 }
 
 Game NewTree(void)  { return new GameTreeRep(); }
@@ -621,54 +800,26 @@ bool GameTreeRep::IsConstSum(void) const
 
 bool GameTreeRep::IsPerfectRecall(GameInfoset &s1, GameInfoset &s2) const
 {
-  for (int pl = 1; pl <= m_players.Length(); pl++)   {
-    GamePlayerRep *player = m_players[pl];
-    
-    for (int i = 1; i <= player->NumInfosets(); i++)  {
-      GameTreeInfosetRep *iset1 = player->m_infosets[i];
-      for (int j = 1; j <= player->NumInfosets(); j++)   {
-	GameTreeInfosetRep *iset2 = player->m_infosets[j];
-
-	bool precedes = false;
-	int action = 0;
-	
-	for (int m = 1; m <= iset2->NumMembers(); m++)  {
-	  int n;
-	  for (n = 1; n <= iset1->NumMembers(); n++)  {
-	    if (iset2->GetMember(m)->IsSuccessorOf(iset1->GetMember(n)) &&
-	        iset1->GetMember(n) != iset2->GetMember(m))  {
-	      precedes = true;
-	      for (int act = 1; act <= iset1->NumActions(); act++)  {
-		if (iset2->GetMember(m)->IsSuccessorOf(iset1->GetMember(n)->GetChild(act))) {
-		  if (action != 0 && action != act)  {
-		    s1 = iset1;
-		    s2 = iset2;
-		    return false;
-		  }
-		  action = act;
-		}
-	      }
-	      break;
-	    }
-	  }
-	  
-	  if (i == j && precedes)  {
-	    s1 = iset1;
-	    s2 = iset2;
-	    return false;
-	  }
-
-	  if (n > iset1->NumMembers() && precedes)  {
-	    s1 = iset1;
-	    s2 = iset2;
-	    return false;
-	  }
-	}
-      }
-    }
+  const CompiledGameTree &tree = GetCompiledTree();
+  if (tree.NumRecallViolations() == 0) {
+    return true;
   }
+  s1 = tree.GetInfosetRep(tree.GetRecallViolation(1).first);
+  s2 = tree.GetInfosetRep(tree.GetRecallViolation(1).second);
+  return false;
+}
 
-  return true;
+List<std::pair<GameInfoset, GameInfoset> > 
+GameTreeRep::GetRecallViolations(void) const
+{
+  const CompiledGameTree &tree = GetCompiledTree();
+  List<std::pair<GameInfoset, GameInfoset> > violations;
+  for (int i = 1; i <= tree.NumRecallViolations(); i++) {
+    const std::pair<int, int> &violation = tree.GetRecallViolation(i);
+    violations.push_back(std::make_pair(GameInfoset(tree.GetInfosetRep(violation.first)),
+					GameInfoset(tree.GetInfosetRep(violation.second))));
+  }
+  return violations;
 }
 
 
@@ -683,48 +834,65 @@ void GameTreeRep::NumberNodes(GameTreeNodeRep *n, int &index)
        NumberNodes(n->children[child++], index));
 } 
 
+namespace {
+
+/// Sorts the array into increasing order of the keys, which are given
+/// for the elements in their current order.  Elements with equal keys
+/// keep their relative order.  As the array is usually sorted already,
+/// this is checked first.
+template <class T>
+void SortByKeys(Array<T> &p_array, const std::vector<int> &p_keys)
+{
+  bool sorted = true;
+  std::vector<std::pair<int, int> > order;
+  order.reserve(p_keys.size());
+  for (size_t i = 0; i < p_keys.size(); i++) {
+    order.push_back(std::make_pair(p_keys[i], i + 1));
+    if (i > 0 && p_keys[i] < p_keys[i - 1])  sorted = false;
+  }
+  if (sorted)  return;
+
+  std::sort(order.begin(), order.end());
+  Array<T> copy(p_array);
+  for (size_t i = 0; i < order.size(); i++) {
+    p_array[i + 1] = copy[order[i].second];
+  }
+}
+
+}  // end anonymous namespace
+
 void GameTreeRep::Canonicalize(void)
 {
   if (!m_doCanon)  return;
+  // Nodes and information sets may be renumbered
+  delete m_compiled;
+  m_compiled = 0;
   int nodeindex = 1;
   NumberNodes(m_root, nodeindex);
 
+  std::vector<int> keys;
   for (int pl = 0; pl <= m_players.Length(); pl++) {
     GamePlayerRep *player = (pl) ? m_players[pl] : m_chance;
     
-    // Sort nodes within information sets according to ID.
-    // Coded using a bubble sort for simplicity; large games might
-    // find a quicksort worthwhile.
+    // Sort nodes within information sets according to ID
     for (int iset = 1; iset <= player->m_infosets.Length(); iset++) {
       GameTreeInfosetRep *infoset = player->m_infosets[iset];
-      for (int i = 1; i < infoset->m_members.Length(); i++) {
-	for (int j = 1; j < infoset->m_members.Length() - i; j++) {
-	  if (infoset->m_members[j+1]->number < infoset->m_members[j]->number) {
-	    GameTreeNodeRep *tmp = infoset->m_members[j];
-	    infoset->m_members[j] = infoset->m_members[j+1];
-	    infoset->m_members[j+1] = tmp;
-	  }
-	}
+      keys.clear();
+      for (int i = 1; i <= infoset->m_members.Length(); i++) {
+	keys.push_back(infoset->m_members[i]->number);
       }
+      SortByKeys(infoset->m_members, keys);
     }
 
-    // Sort information sets by the smallest ID among their members
-    // Coded using a bubble sort for simplicity; large games might
-    // find a quicksort worthwhile.
-    for (int i = 1; i < player->m_infosets.Length(); i++) {
-      for (int j = 1; j < player->m_infosets.Length() - i; j++) {
-	int a = ((player->m_infosets[j+1]->m_members.Length()) ?
-		 player->m_infosets[j+1]->m_members[1]->number : 0);
-	int b = ((player->m_infosets[j]->m_members.Length()) ?
-		 player->m_infosets[j]->m_members[1]->number : 0);
-
-	if (a < b || b == 0) {
-	  GameTreeInfosetRep *tmp = player->m_infosets[j];
-	  player->m_infosets[j] = player->m_infosets[j+1];
-	  player->m_infosets[j+1] = tmp;
-	}
-      }
+    // Sort information sets by the smallest ID among their members,
+    // placing any without members last
+    keys.clear();
+    for (int iset = 1; iset <= player->m_infosets.Length(); iset++) {
+      GameTreeInfosetRep *infoset = player->m_infosets[iset];
+      keys.push_back((infoset->m_members.Length()) ?
+		     infoset->m_members[1]->number : nodeindex);
     }
+    SortByKeys(player->m_infosets, keys);
 
     // Reassign information set IDs
     for (int iset = 1; iset <= player->m_infosets.Length(); iset++) {
@@ -733,6 +901,20 @@ void GameTreeRep::Canonicalize(void)
   }
 }
 
+DeferredCanonicalization::DeferredCanonicalization(const Game &p_game)
+  : m_game(p_game)
+{
+  GameTreeRep *tree = dynamic_cast<GameTreeRep *>(m_game.operator->());
+  if (!tree)  throw UndefinedException();
+  m_previous = tree->GetCanonicalization();
+  tree->SetCanonicalization(false);
+}
+
+DeferredCanonicalization::~DeferredCanonicalization()
+{
+  dynamic_cast<GameTreeRep &>(*m_game).SetCanonicalization(m_previous);
+}
+
 void GameTreeRep::ClearComputedValues(void) const
 {
   for (int pl = 1; pl <= m_players.Length(); pl++) {
@@ -741,6 +923,8 @@ void GameTreeRep::ClearComputedValues(void) const
     }
   }
 
+  delete m_compiled;
+  m_compiled = 0;
   m_computedValues = false;
 }
 
@@ -762,6 +946,205 @@ void GameTreeRep::BuildComputedValues(void)
   m_computedValues = true;
 }
 
+void GameTreeRep::MakeShared(void)
+{
+  GameExplicitRep::MakeShared();
+  GetCompiledTree();
+
+  for (int pl = 0; pl <= m_players.Length(); pl++) {
+    GamePlayerRep *player = (pl) ? m_players[pl] : m_chance;
+    for (int iset = 1; iset <= player->m_infosets.Length(); iset++) {
+      GameTreeInfosetRep *infoset = player->m_infosets[iset];
+      for (int act = 1; act <= infoset->m_actions.Length(); 
+	   infoset->m_actions[act++]->Share());
+      infoset->Share();
+    }
+  }
+  m_chance->Share();
+
+  std::vector<GameTreeNodeRep *> nodes(1, m_root);
+  while (!nodes.empty()) {
+    GameTreeNodeRep *node = nodes.back();
+    nodes.pop_back();
+    node->Share();
+    for (int i = 1; i <= node->children.Length(); 
+	 nodes.push_back(node->children[i++]));
+  }
+}
+
+//------------------------------------------------------------------------
+//                     GameTreeRep: Compiled tree
+//------------------------------------------------------------------------
+
+int GameTreeRep::CompileNode(CompiledGameTree &p_tree, GameTreeNodeRep *p_node,
+			     int p_parent,
+			     std::vector<std::vector<int> > &p_members) const
+{
+  p_tree.m_nodeNumber.Append(p_node->number);
+  int pos = p_tree.m_parent.Append(p_parent);
+  p_tree.m_outcome.Append(p_node->outcome);
+  p_tree.m_priorAction.Append(0);
+  p_tree.m_childStart.Append(0);
+  p_tree.m_numChildren.Append(p_node->children.Length());
+  p_tree.m_subtreeEnd.Append(0);
+
+  if (!p_node->infoset) {
+    p_tree.m_infoset.Append(0);
+  }
+  else {
+    GameTreeInfosetRep *infoset = p_node->infoset;
+    int iset = p_tree.GetInfosetIndex(infoset->m_player->m_number,
+				      infoset->m_number);
+    p_tree.m_infoset.Append(iset);
+    p_members[iset - 1].push_back(pos);
+
+    // The children's positions are only known once their subtrees
+    // are compiled, so they are collected before being stored together
+    std::vector<int> children;
+    children.reserve(p_node->children.Length());
+    for (int i = 1; i <= p_node->children.Length(); i++) {
+      int child = CompileNode(p_tree, p_node->children[i], pos, p_members);
+      p_tree.m_priorAction[child] = p_tree.m_firstAction[iset] + i - 1;
+      children.push_back(child);
+    }
+    p_tree.m_childStart[pos] = p_tree.m_children.Length() + 1;
+    for (size_t i = 0; i < children.size(); i++) {
+      p_tree.m_children.Append(children[i]);
+    }
+  }
+
+  p_tree.m_subtreeEnd[pos] = p_tree.m_nodeNumber.Length();
+  p_tree.m_postorder.Append(pos);
+  return pos;
+}
+
+const CompiledGameTree &GameTreeRep::GetCompiledTree(void) const
+{
+  if (m_compiled) {
+    return *m_compiled;
+  }
+
+  CompiledGameTree *tree = new CompiledGameTree(m_players.Length());
+  // Personal players first, in order, then chance
+  int offset = 0, action = 1;
+  for (int i = 1; i <= m_players.Length() + 1; i++) {
+    int pl = (i <= m_players.Length()) ? i : 0;
+    GamePlayerRep *player = (pl) ? m_players[pl] : m_chance;
+    tree->m_infosetOffset[pl] = offset;
+    for (int iset = 1; iset <= player->m_infosets.Length(); iset++) {
+      GameTreeInfosetRep *infoset = player->m_infosets[iset];
+      tree->m_infosets.Append(infoset);
+      tree->m_infosetPlayer.Append(pl);
+      tree->m_firstAction.Append(action);
+      action += infoset->m_actions.Length();
+    }
+    offset += player->m_infosets.Length();
+  }
+  tree->m_firstAction.Append(action);
+
+  int numNodes = NumNodes();
+  tree->m_nodeNumber.reserve(numNodes);
+  tree->m_parent.reserve(numNodes);
+  tree->m_outcome.reserve(numNodes);
+  tree->m_priorAction.reserve(numNodes);
+  tree->m_childStart.reserve(numNodes);
+  tree->m_numChildren.reserve(numNodes);
+  tree->m_infoset.reserve(numNodes);
+  tree->m_postorder.reserve(numNodes);
+  tree->m_subtreeEnd.reserve(numNodes);
+  tree->m_children.reserve(numNodes);
+
+  std::vector<std::vector<int> > members(tree->NumInfosets());
+  CompileNode(*tree, m_root, 0, members);
+
+  // Members are listed in preorder, which is the order in which
+  // Canonicalize() sorts them
+  for (int iset = 1; iset <= tree->NumInfosets(); iset++) {
+    tree->m_memberStart.Append(tree->m_members.Length() + 1);
+    for (size_t i = 0; i < members[iset - 1].size(); i++) {
+      tree->m_members.Append(members[iset - 1][i]);
+    }
+  }
+  tree->m_memberStart.Append(tree->m_members.Length() + 1);
+
+  // Label each node by the last action, on the path to it, of each
+  // player in turn.  The members of an information set must share a
+  // label if they are to be reached by the same sequence of the player's
+  // actions.  Conversely, if they all do, then the members of the
+  // information sets at which the labels end share their sequences too,
+  // and so on back to the root; thus the label stands for the sequence.
+  // For each information set whose members differ, there is a violation
+  // paired with the information set of each (nonzero) label.
+  Array<int> actionInfoset(tree->NumActions());
+  for (int iset = 1; iset <= tree->NumInfosets(); iset++) {
+    for (int act = 1; act <= tree->NumActions(iset); act++) {
+      actionInfoset[tree->GetFirstAction(iset) + act - 1] = iset;
+    }
+  }
+  tree->m_perfectRecall = Array<bool>(m_players.Length());
+  Array<int> label(numNodes);
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    tree->m_perfectRecall[pl] = true;
+    label[1] = 0;
+    for (int node = 2; node <= numNodes; node++) {
+      int parent = tree->GetParent(node);
+      label[node] = ((tree->GetInfosetPlayer(tree->GetInfoset(parent)) == pl) ?
+		     tree->GetPriorAction(node) : label[parent]);
+    }
+    for (int i = 1; i <= m_players[pl]->m_infosets.Length(); i++) {
+      int iset = tree->GetInfosetIndex(pl, i);
+      std::vector<int> labels;
+      for (int mem = 1; mem <= tree->NumMembers(iset); mem++) {
+	labels.push_back(label[tree->GetMember(iset, mem)]);
+      }
+      std::sort(labels.begin(), labels.end());
+      labels.erase(std::unique(labels.begin(), labels.end()), labels.end());
+      if (labels.size() <= 1)  continue;
+
+      tree->m_perfectRecall[pl] = false;
+      std::vector<int> prior;
+      for (size_t j = 0; j < labels.size(); j++) {
+	if (labels[j] > 0)  prior.push_back(actionInfoset[labels[j]]);
+      }
+      prior.erase(std::unique(prior.begin(), prior.end()), prior.end());
+      for (size_t j = 0; j < prior.size(); j++) {
+	tree->m_recallViolations.push_back(std::make_pair(prior[j], iset));
+      }
+    }
+  }
+  std::sort(tree->m_recallViolations.begin(), tree->m_recallViolations.end());
+
+  // A node is the root of a subgame if it is the only member of its
+  // information set, and each information set of the personal players
+  // with a member in its subtree has all its members there.  As members
+  // are listed in preorder, it is enough that the first and last members
+  // lie in the subtree; the extremes of these over each subtree are
+  // accumulated in postorder.
+  tree->m_subgameRoot = Array<bool>(numNodes);
+  Array<int> first(numNodes), last(numNodes);
+  for (int i = 1; i <= numNodes; i++) {
+    int node = tree->GetPostorder(i), iset = tree->GetInfoset(node);
+    first[node] = last[node] = node;
+    tree->m_subgameRoot[node] = false;
+    if (!iset)  continue;
+    if (tree->GetInfosetPlayer(iset) != 0) {
+      first[node] = tree->GetMember(iset, 1);
+      last[node] = tree->GetMember(iset, tree->NumMembers(iset));
+    }
+    for (int j = 1; j <= tree->NumChildren(node); j++) {
+      int child = tree->GetChild(node, j);
+      if (first[child] < first[node])  first[node] = first[child];
+      if (last[child] > last[node])  last[node] = last[child];
+    }
+    tree->m_subgameRoot[node] = (tree->NumMembers(iset) == 1 &&
+				 first[node] >= node &&
+				 last[node] <= tree->GetSubtreeEnd(node));
+  }
+
+  m_compiled = tree;
+  return *m_compiled;
+}
+
 //------------------------------------------------------------------------
 //                  GameTreeRep: Writing data files
 //------------------------------------------------------------------------
@@ -886,6 +1269,63 @@ void GameTreeRep::WriteNfgFile(std::ostream &p_file) const
   GameRep::WriteNfgFile(p_file);
 }
 
+namespace {
+
+void WriteBinaryNode(BinaryFileWriter &p_file, const GameNode &p_node)
+{
+  p_file.Write<uint32_t>(p_node->GetNumber());
+  p_file.WriteString(p_node->GetLabel());
+  p_file.Write<uint32_t>((p_node->GetOutcome()) ? 
+			 p_node->GetOutcome()->GetNumber() : 0);
+  if (p_node->NumChildren() == 0) {
+    p_file.Write<int32_t>(-1);
+    return;
+  }
+  p_file.Write<int32_t>(p_node->GetInfoset()->GetPlayer()->GetNumber());
+  p_file.Write<uint32_t>(p_node->GetInfoset()->GetNumber());
+  for (int i = 1; i <= p_node->NumChildren(); i++) {
+    WriteBinaryNode(p_file, p_node->GetChild(i));
+  }
+}
+
+}  // end anonymous namespace
+
+void GameTreeRep::WriteBinaryFile(std::ostream &p_file) const
+{
+  BinaryFileWriter file(p_file);
+  file.WriteHeader(BINARY_GAME_TREE);
+  file.WriteString(m_title);
+  file.WriteString(m_comment);
+  file.WriteCount(m_players.Length());
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    file.WriteString(m_players[pl]->m_label);
+  }
+
+  file.WriteCount(m_outcomes.Length());
+  for (int outc = 1; outc <= m_outcomes.Length(); outc++) {
+    file.WriteString(m_outcomes[outc]->m_label);
+  }
+  m_payoffs.WriteBinary(file);
+
+  for (int pl = 0; pl <= m_players.Length(); pl++) {
+    GamePlayerRep *player = (pl) ? m_players[pl] : m_chance;
+    file.WriteCount(player->m_infosets.Length());
+    for (int iset = 1; iset <= player->m_infosets.Length(); iset++) {
+      GameTreeInfosetRep *infoset = player->m_infosets[iset];
+      file.WriteString(infoset->m_label);
+      file.WriteCount(infoset->m_actions.Length());
+      for (int act = 1; act <= infoset->m_actions.Length(); act++) {
+	file.WriteString(infoset->m_actions[act]->m_label);
+	if (player->IsChance()) {
+	  file.WriteString(infoset->GetActionProb(act, ""));
+	}
+      }
+    }
+  }
+
+  WriteBinaryNode(file, m_root);
+}
+
 //------------------------------------------------------------------------
 //                 GameTreeRep: Dimensions of the game
 //------------------------------------------------------------------------
@@ -940,12 +1380,11 @@ int GameTreeRep::BehavProfileLength(void) const
 
 GamePlayer GameTreeRep::NewPlayer(void)
 {
+  CheckMutable();
   GamePlayerRep *player = 0;
   player = new GamePlayerRep(this, m_players.Length() + 1);
   m_players.Append(player);
-  for (int outc = 1; outc <= m_outcomes.Last(); outc++) {
-    m_outcomes[outc]->m_payoffs.Append(Number());
-  }
+  m_payoffs.AddPlayer();
   ClearComputedValues();
   return player;
 }
@@ -1001,7 +1440,9 @@ GameAction GameTreeRep::GetAction(int p_index) const
 
 void GameTreeRep::DeleteOutcome(const GameOutcome &p_outcome)
 {
+  CheckMutable();
   m_root->DeleteOutcome(p_outcome);
+  m_payoffs.RemoveOutcome(p_outcome->GetNumber());
   m_outcomes.Remove(m_outcomes.Find(p_outcome))->Invalidate();
   for (int outc = 1; outc <= m_outcomes.Length(); outc++) {
     m_outcomes[outc]->m_number = outc;
@@ -1072,11 +1513,21 @@ MixedStrategyProfile<Rational> GameTreeRep::NewMixedStrategyProfile(const Ration
 
 class TreePureStrategyProfileRep : public PureStrategyProfileRep {
 protected:
+  /// The action chosen at each personal information set, numbered as in
+  /// CompiledGameTree, or zero where the player's strategy does not reach it
+  Array<int> m_actions;
+
   virtual PureStrategyProfileRep *Copy(void) const;
 
+  const CompiledGameTree &GetTree(void) const
+  { return static_cast<GameTreeRep *>(m_nfg.operator->())->GetCompiledTree(); }
+  /// Returns the payoff to player pl when player p_deviator plays the
+  /// actions in p_behav (indexed by the player's information sets)
+  /// and the other players follow the profile
+  Rational GetPayoff(int pl, int p_deviator, const Array<int> &p_behav) const;
+
 public:
-  TreePureStrategyProfileRep(const Game &p_game)
-    : PureStrategyProfileRep(p_game) { }
+  TreePureStrategyProfileRep(const Game &p_game);
   virtual void SetStrategy(const GameStrategy &);
   virtual GameOutcome GetOutcome(void) const
   { throw UndefinedException(); }
@@ -1084,12 +1535,22 @@ public:
   { throw UndefinedException(); }
   virtual Rational GetPayoff(int pl) const;
   virtual Rational GetStrategyValue(const GameStrategy &) const;
+  virtual Array<Rational> GetStrategyValues(const GamePlayer &) const;
 };
 
 //------------------------------------------------------------------------
 //              TreePureStrategyProfileRep: Lifecycle
 //------------------------------------------------------------------------
 
+TreePureStrategyProfileRep::TreePureStrategyProfileRep(const Game &p_game)
+  : PureStrategyProfileRep(p_game),
+    m_actions(GetTree().NumPersonalInfosets())
+{
+  for (int pl = 1; pl <= m_nfg->NumPlayers(); pl++) {
+    SetStrategy(m_profile[pl]);
+  }
+}
+
 PureStrategyProfileRep *TreePureStrategyProfileRep::Copy(void) const
 {
   return new TreePureStrategyProfileRep(*this);
@@ -1106,31 +1567,312 @@ PureStrategyProfile GameTreeRep::NewPureStrategyProfile(void) const
 
 void TreePureStrategyProfileRep::SetStrategy(const GameStrategy &s)
 {
-  m_profile[s->GetPlayer()->GetNumber()] = s;
+  int pl = s->GetPlayer()->GetNumber();
+  m_profile[pl] = s;
+  int offset = GetTree().GetInfosetIndex(pl, 0);
+  for (int iset = 1; iset <= s->m_behav.Length(); iset++) {
+    m_actions[offset + iset] = s->m_behav[iset];
+  }
 }
 
-Rational TreePureStrategyProfileRep::GetPayoff(int pl) const
+//
+// Only the nodes on the paths played are visited: one path, if there
+// are no chance moves, and otherwise the paths through every action of
+// chance with positive probability.
+//
+Rational TreePureStrategyProfileRep::GetPayoff(int pl, int p_deviator,
+					       const Array<int> &p_behav) const
 {
-  PureBehaviorProfile behav(m_nfg);
-  for (int i = 1; i <= m_nfg->NumPlayers(); i++) {
-    GamePlayer player = m_nfg->GetPlayer(i);
-    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
-      int act = m_profile[i]->m_behav[iset];
-      if (act) {
-	behav.SetAction(player->GetInfoset(iset)->GetAction(act));
+  const CompiledGameTree &tree = GetTree();
+  int offset = tree.GetInfosetIndex(p_deviator, 0);
+  Rational payoff(0);
+  std::vector<std::pair<int, Rational> > stack;
+  stack.push_back(std::make_pair(1, Rational(1)));
+  while (!stack.empty()) {
+    int node = stack.back().first;
+    Rational prob = stack.back().second;
+    stack.pop_back();
+
+    for (;;) {
+      if (tree.GetOutcome(node)) {
+	payoff += prob * tree.GetOutcome(node)->GetPayoff<Rational>(pl);
+      }
+      int infoset = tree.GetInfoset(node);
+      if (!infoset)  break;
+      int player = tree.GetInfosetPlayer(infoset);
+      if (player == 0) {
+	// Continue along the last action, stacking the others
+	GameTreeInfosetRep *rep = tree.GetInfosetRep(infoset);
+	int act = tree.NumActions(infoset);
+	for (int i = 1; i < act; i++) {
+	  Rational p = rep->GetActionProb(i, Rational(0));
+	  if (p != Rational(0)) {
+	    stack.push_back(std::make_pair(tree.GetChild(node, i), prob * p));
+	  }
+	}
+	prob *= rep->GetActionProb(act, Rational(0));
+	if (prob == Rational(0))  break;
+	node = tree.GetChild(node, act);
+      }
+      else if (player == p_deviator) {
+	node = tree.GetChild(node, p_behav[infoset - offset]);
+      }
+      else {
+	node = tree.GetChild(node, m_actions[infoset]);
       }
     }
   }
-  return behav.GetPayoff<Rational>(pl);
+  return payoff;
+}
+
+Rational TreePureStrategyProfileRep::GetPayoff(int pl) const
+{
+  return GetPayoff(pl, pl, m_profile[pl]->m_behav);
 }
 
 Rational
 TreePureStrategyProfileRep::GetStrategyValue(const GameStrategy &p_strategy) const
 {
-  PureStrategyProfile copy = Copy();
-  copy->SetStrategy(p_strategy);
-  return copy->GetPayoff(p_strategy->GetPlayer()->GetNumber());
+  int pl = p_strategy->GetPlayer()->GetNumber();
+  return GetPayoff(pl, pl, p_strategy->m_behav);
+}
+
+//
+// With the other players' actions fixed, the tree is traversed once,
+// branching at all the player's actions.  The payoffs collected at each
+// node are credited to the last action of the player on the path to it.
+// With perfect recall, a (reduced) strategy reaches a node exactly when
+// it plays that action, so the value of a strategy is the sum of the
+// payoffs credited to the actions it plays.
+//
+Array<Rational>
+TreePureStrategyProfileRep::GetStrategyValues(const GamePlayer &p_player) const
+{
+  int pl = p_player->GetNumber();
+  const CompiledGameTree &tree = GetTree();
+  if (!tree.IsPerfectRecall(pl)) {
+    return PureStrategyProfileRep::GetStrategyValues(p_player);
+  }
+
+  Array<Rational> credit(0, tree.NumActions());
+  for (int i = 0; i <= tree.NumActions(); i++) {
+    credit[i] = Rational(0);
+  }
+  // Entries are the node, the probability of chance's moves, and the
+  // last action of the player
+  std::vector<std::pair<std::pair<int, int>, Rational> > stack;
+  stack.push_back(std::make_pair(std::make_pair(1, 0), Rational(1)));
+  while (!stack.empty()) {
+    int node = stack.back().first.first;
+    int action = stack.back().first.second;
+    Rational prob = stack.back().second;
+    stack.pop_back();
+
+    if (tree.GetOutcome(node)) {
+      credit[action] += prob * tree.GetOutcome(node)->GetPayoff<Rational>(pl);
+    }
+    int infoset = tree.GetInfoset(node);
+    if (!infoset)  continue;
+    int player = tree.GetInfosetPlayer(infoset);
+    if (player == 0) {
+      GameTreeInfosetRep *rep = tree.GetInfosetRep(infoset);
+      for (int i = 1; i <= tree.NumActions(infoset); i++) {
+	Rational p = rep->GetActionProb(i, Rational(0));
+	if (p != Rational(0)) {
+	  stack.push_back(std::make_pair(std::make_pair(tree.GetChild(node, i),
+							action), prob * p));
+	}
+      }
+    }
+    else if (player == pl) {
+      for (int i = 1; i <= tree.NumActions(infoset); i++) {
+	stack.push_back(std::make_pair(std::make_pair(tree.GetChild(node, i),
+						      tree.GetFirstAction(infoset) + i - 1),
+				       prob));
+      }
+    }
+    else {
+      stack.push_back(std::make_pair(std::make_pair(tree.GetChild(node, m_actions[infoset]),
+						    action), prob));
+    }
+  }
+
+  Array<Rational> values(p_player->NumStrategies());
+  for (int st = 1; st <= values.Length(); st++) {
+    const Array<int> &behav = p_player->GetStrategy(st)->m_behav;
+    values[st] = credit[0];
+    for (int iset = 1; iset <= behav.Length(); iset++) {
+      if (behav[iset]) {
+	values[st] += credit[tree.GetFirstAction(tree.GetInfosetIndex(pl, iset)) +
+			     behav[iset] - 1];
+      }
+    }
+  }
+  return values;
+}
+
+//========================================================================
+//                      class ReducedStrategySpace
+//========================================================================
+
+//
+// Strategies are generated by walking the tree in preorder, following
+// only the chosen action at the player's nodes; the action at each
+// information set is chosen on first reaching it, with the choices
+// made earlier varying more slowly.  When the player has perfect
+// recall, the number of ways to complete a strategy is the product of
+// the number of ways of choosing at the information sets reached but
+// not yet decided, as these follow different actions of the player.
+// Each choice thus picks out a block of consecutive strategies, whose
+// size is known.
+//
+ReducedStrategySpace::ReducedStrategySpace(const GamePlayer &p_player)
+  : m_player(p_player->GetNumber()), m_numInfosets(p_player->NumInfosets())
+{
+  GameTreeRep *game = dynamic_cast<GameTreeRep *>(p_player->GetGame().operator->());
+  if (!game || p_player->IsChance())  throw UndefinedException();
+  const CompiledGameTree &tree = game->GetCompiledTree();
+
+  // Copy the structure needed from the tree, numbering the sequences
+  // of the player by the last action taken
+  int numNodes = tree.NumNodes(), numSequences = 0;
+  m_firstSequence = Array<int>(m_numInfosets);
+  for (int iset = 1; iset <= m_numInfosets; iset++) {
+    m_firstSequence[iset] = numSequences + 1;
+    numSequences += p_player->GetInfoset(iset)->NumActions();
+  }
+  m_infoset = Array<int>(numNodes);
+  m_childStart = Array<int>(numNodes);
+  m_numChildren = Array<int>(numNodes);
+  m_children.reserve(numNodes);
+
+  Array<int> sequence(numNodes), parentSequence(m_numInfosets), firstNode(m_numInfosets);
+  for (int iset = 1; iset <= m_numInfosets; iset++) {
+    firstNode[iset] = 0;
+  }
+  for (int node = 1; node <= numNodes; node++) {
+    int parent = tree.GetParent(node);
+    sequence[node] = 0;
+    if (parent) {
+      sequence[node] = sequence[parent];
+      if (m_infoset[parent]) {
+	int iset = m_infoset[parent];
+	int act = tree.GetPriorAction(node) - tree.GetFirstAction(tree.GetInfoset(parent)) + 1;
+	sequence[node] = m_firstSequence[iset] + act - 1;
+      }
+    }
+
+    int iset = tree.GetInfoset(node);
+    m_infoset[node] = 0;
+    if (iset && tree.GetInfosetPlayer(iset) == m_player) {
+      m_infoset[node] = tree.GetInfosetRep(iset)->GetNumber();
+      int number = m_infoset[node];
+      if (!firstNode[number]) {
+	firstNode[number] = node;
+	parentSequence[number] = sequence[node];
+      }
+      else if (parentSequence[number] != sequence[node]) {
+	throw UndefinedException("Reduced strategies can only be counted for players with perfect recall.");
+      }
+    }
+
+    m_childStart[node] = m_children.Length() + 1;
+    m_numChildren[node] = tree.NumChildren(node);
+    for (int child = 1; child <= tree.NumChildren(node); child++) {
+      m_children.Append(tree.GetChild(node, child));
+    }
+  }
+
+  // Information sets which follow a sequence come after it in preorder,
+  // so working backwards from the last one reached finds the counts
+  // which each count depends on first
+  std::vector<std::pair<int, int> > order;
+  for (int iset = 1; iset <= m_numInfosets; iset++) {
+    if (firstNode[iset])  order.push_back(std::pair<int, int>(firstNode[iset], iset));
+  }
+  std::sort(order.begin(), order.end());
+  m_following = Array<Integer>(0, numSequences);
+  m_choices = Array<Integer>(m_numInfosets);
+  for (int seq = 0; seq <= numSequences; seq++) {
+    m_following[seq] = 1;
+  }
+  for (int i = order.size() - 1; i >= 0; i--) {
+    int iset = order[i].second;
+    int numActions = p_player->GetInfoset(iset)->NumActions();
+    m_choices[iset] = 0;
+    for (int act = 1; act <= numActions; act++) {
+      m_choices[iset] += m_following[m_firstSequence[iset] + act - 1];
+    }
+    m_following[parentSequence[iset]] *= m_choices[iset];
+  }
+}
+
+void ReducedStrategySpace::Walk(Integer &p_index, Array<int> &p_behav,
+				bool p_find) const
+{
+  // When finding a strategy, p_index counts down from the position of the
+  // strategy sought; otherwise it counts up to the strategy's position
+  Integer remaining = NumStrategies();
+  Array<int> chosen(m_numInfosets);
+  for (int iset = 1; iset <= m_numInfosets; iset++) {
+    chosen[iset] = 0;
+  }
+  if (p_find)  p_index -= 1;  else  p_index = 0;
+
+  std::vector<int> stack(1, 1);
+  while (!stack.empty()) {
+    int node = stack.back();
+    stack.pop_back();
+    int iset = m_infoset[node];
+    if (!iset) {
+      for (int child = m_numChildren[node]; child >= 1; child--) {
+	stack.push_back(m_children[m_childStart[node] + child - 1]);
+      }
+      continue;
+    }
+
+    if (!chosen[iset]) {
+      Integer rest = remaining / m_choices[iset];
+      int first = m_firstSequence[iset], act = 1;
+      if (p_find) {
+	for (; act < m_numChildren[node]; act++) {
+	  Integer block = m_following[first + act - 1] * rest;
+	  if (p_index < block)  break;
+	  p_index -= block;
+	}
+      }
+      else {
+	act = p_behav[iset];
+	if (act < 1 || act > m_numChildren[node])  throw IndexException();
+	for (int prev = 1; prev < act; prev++) {
+	  p_index += m_following[first + prev - 1] * rest;
+	}
+      }
+      remaining = m_following[first + act - 1] * rest;
+      chosen[iset] = act;
+    }
+    stack.push_back(m_children[m_childStart[node] + chosen[iset] - 1]);
+  }
+
+  if (p_find)  p_behav = chosen;  else  p_index += 1;
+}
+
+Array<int> ReducedStrategySpace::GetStrategy(const Integer &p_index) const
+{
+  if (p_index < 1 || p_index > NumStrategies())  throw IndexException();
+  Integer index = p_index;
+  Array<int> behav;
+  Walk(index, behav, true);
+  return behav;
 }
 
+Integer ReducedStrategySpace::GetIndex(const Array<int> &p_behav) const
+{
+  if (p_behav.Length() != m_numInfosets)  throw DimensionException();
+  Integer index;
+  Array<int> behav(p_behav);
+  Walk(index, behav, false);
+  return index;
+}
 
 }  // end namespace Gambit
@@ -94,11 +94,6 @@ long lg(unsigned long x)
 #define MALLOC_MIN_OVERHEAD 4
 #endif
 
-static IntegerRep _ZeroRep = {1, 0, 1, {0}};
-static IntegerRep _OneRep = {1, 0, 1, {1}};
-static IntegerRep _MinusOneRep = {1, 0, 0, {1}};
-
-
 // utilities to extract and transfer bits
 
 // get low bits
@@ -122,6 +117,66 @@ inline static unsigned long up(unsigned long x)
   return x << I_SHIFT;
 }
 
+//
+// Values which fit in a long (other than LONG_MIN) are held inline in
+// m_small, and rep is then null.  The Integer functions work directly
+// on those values when they can, checking for overflow, and otherwise
+// view the operands as IntegerReps and call the IntegerRep routines.
+// Every result is passed through SetSmall() or SetRep(), which return
+// it to the inline form whenever it fits.
+//
+
+/// Storage on the stack for viewing a long as an IntegerRep
+struct IntegerLongRep {
+  unsigned short m_storage[sizeof(IntegerRep) / sizeof(unsigned short) +
+			   SHORT_PER_LONG];
+};
+
+namespace {
+
+// The magnitude of a long, including LONG_MIN
+inline unsigned long Magnitude(long x)
+{
+  return (x >= 0) ? (unsigned long) x : -(unsigned long) x;
+}
+
+// Each of these returns true if the result does not fit inline;
+// otherwise the result is stored in r.  The arguments are never LONG_MIN.
+
+inline bool AddOverflows(long x, long y, long &r)
+{
+#if defined(__GNUC__) && __GNUC__ >= 5
+  return __builtin_add_overflow(x, y, &r) || r == LONG_MIN;
+#else
+  if ((y > 0 && x > LONG_MAX - y) || (y < 0 && x < -LONG_MAX - y))  {
+    return true;
+  }
+  r = x + y;
+  return false;
+#endif  // __GNUC__
+}
+
+inline bool SubOverflows(long x, long y, long &r)
+{
+  return AddOverflows(x, -y, r);
+}
+
+inline bool MulOverflows(long x, long y, long &r)
+{
+#if defined(__GNUC__) && __GNUC__ >= 5
+  return __builtin_mul_overflow(x, y, &r) || r == LONG_MIN;
+#else
+  if (x != 0 && y != 0 &&
+      Magnitude(x) > (unsigned long) LONG_MAX / Magnitude(y))  {
+    return true;
+  }
+  r = x * y;
+  return false;
+#endif  // __GNUC__
+}
+
+}  // end anonymous namespace
+
 // compare two equal-length reps
 
 static int docmp(const unsigned short* x, const unsigned short* y, int l)
@@ -322,7 +377,7 @@ IntegerRep* Icopy_ulong(IntegerRep* old, unsigned long x)
   while (x != 0)
   {
     src[srclen++] = extract(x);
-    x = down(x);
+    x >>= I_SHIFT;
   }
 
   IntegerRep* rep;
@@ -343,11 +398,13 @@ IntegerRep* Icopy_ulong(IntegerRep* old, unsigned long x)
 }
 
 // special case for zero -- it's worth it!
+// These never return a rep shared with other Integers, since the
+// callers go on to modify it, possibly in several threads at once.
 
 IntegerRep* Icopy_zero(IntegerRep* old)
 {
   if (old == 0 || STATIC_IntegerRep(old))
-    return &_ZeroRep;
+    old = Inew(1);
 
   old->len = 0;
   old->sgn = I_POSITIVE;
@@ -362,7 +419,7 @@ IntegerRep* Icopy_one(IntegerRep* old, int newsgn)
   if (old == 0 || 1 > old->sz)
   {
     if (old != 0 && !STATIC_IntegerRep(old)) delete old;
-    return newsgn==I_NEGATIVE ? &_MinusOneRep : &_OneRep;
+    old = Inew(1);
   }
 
   old->sgn = newsgn;
@@ -497,12 +554,19 @@ double ratio(const Integer& num, const Integer& den)
  
   if (d1 >= DBL_MAX || d1 <= -DBL_MAX || sign(r) == 0)
     return d1;
+  else if (!den.rep && (double) Magnitude(den.m_small) < 1.0 / DBL_EPSILON)
+  {
+    // The loop below computes den and r exactly in this case
+    return d1 + (double) r.as_long() / (double) Magnitude(den.m_small);
+  }
   else      // use as much precision as available for fractional part
   {
     double  d2 = 0.0;
     double  d3 = 0.0; 
     int cont = 1;
-    for (int i = den.rep->len - 1; i >= 0 && cont; --i)
+    IntegerLongRep denb, rb;
+    const IntegerRep *denrep = den.GetRep(denb), *rrep = r.GetRep(rb);
+    for (int i = denrep->len - 1; i >= 0 && cont; --i)
     {
 		unsigned short a = (unsigned short) (I_RADIX >> 1);
       while (a != 0)
@@ -514,13 +578,13 @@ double ratio(const Integer& num, const Integer& den)
         }
 
         d2 *= 2.0;
-        if (den.rep->s[i] & a)
+        if (denrep->s[i] & a)
           d2 += 1.0;
 
-        if (i < r.rep->len)
+        if (i < rrep->len)
         {
           d3 *= 2.0;
-          if (r.rep->s[i] & a)
+          if (rrep->s[i] & a)
             d3 += 1.0;
         }
 
@@ -591,7 +655,7 @@ int compare(const IntegerRep* x, long  y)
         while (uy != 0)
         {
           tmp[yl++] = extract(uy);
-          uy = down(uy);
+          uy >>= I_SHIFT;
         }
         diff = xl - yl;
         if (diff == 0)
@@ -620,7 +684,7 @@ int ucompare(const IntegerRep* x, long  y)
       while (uy != 0)
       {
         tmp[yl++] = extract(uy);
-        uy = down(uy);
+        uy >>= I_SHIFT;
       }
       diff = xl - yl;
       if (diff == 0)
@@ -781,11 +845,19 @@ IntegerRep* add(const IntegerRep* x, int negatex, long y, IntegerRep* r)
     while (as < topa && uy != 0)
     {
       unsigned long u = extract(uy);
-      uy = down(uy);
+      uy >>= I_SHIFT;
       sum += (unsigned long)(*as++) + u;
       *rs++ = extract(sum);
       sum = down(sum);
     }
+    // y may have more limbs than x
+    while (uy != 0)
+    {
+      sum += extract(uy);
+      uy >>= I_SHIFT;
+      *rs++ = extract(sum);
+      sum = down(sum);
+    }
     while (sum != 0 && as < topa)
     {
       sum += (unsigned long)(*as++);
@@ -805,7 +877,7 @@ IntegerRep* add(const IntegerRep* x, int negatex, long y, IntegerRep* r)
     while (uy != 0)
     {
       tmp[yl++] = extract(uy);
-      uy = down(uy);
+      uy >>= I_SHIFT;
     }
     int comp = xl - yl;
     if (comp == 0)
@@ -1033,7 +1105,7 @@ IntegerRep* multiply(const IntegerRep* x, long y, IntegerRep* r)
     while (uy != 0)
     {
       tmp[yl++] = extract(uy);
-      uy = down(uy);
+      uy >>= I_SHIFT;
     }
 
     int rl = xl + yl;
@@ -1296,7 +1368,7 @@ IntegerRep* div(const IntegerRep* x, long y, IntegerRep* q)
   while (u != 0)
   {
     ys[yl++] = extract(u);
-    u = down(u);
+    u >>= I_SHIFT;
   }
 
   int comp = xl - yl;
@@ -1322,10 +1394,13 @@ IntegerRep* div(const IntegerRep* x, long y, IntegerRep* q)
 	 unsigned short prescale = (unsigned short) (I_RADIX / (1 + ys[yl - 1]));
     if (prescale != 1)
     {
-      unsigned long prod = (unsigned long)prescale * (unsigned long)ys[0];
-      ys[0] = extract(prod);
-      prod = down(prod) + (unsigned long)prescale * (unsigned long)ys[1];
-      ys[1] = extract(prod);
+      unsigned long prod = 0;
+      for (int i = 0; i < yl; ++i)
+      {
+        prod += (unsigned long)prescale * (unsigned long)ys[i];
+        ys[i] = extract(prod);
+        prod = down(prod);
+      }
       r = multiply(x, ((long)prescale & I_MAXNUM), r);
     }
     else
@@ -1349,7 +1424,15 @@ IntegerRep* div(const IntegerRep* x, long y, IntegerRep* q)
 
 void divide(const Integer& Ix, long y, Integer& Iq, long& rem)
 {
-  const IntegerRep* x = Ix.rep;
+  if (!Ix.rep && y != LONG_MIN && y != 0)
+  {
+    long x = Ix.m_small;
+    rem = x % y;
+    Iq.SetSmall(x / y);
+    return;
+  }
+  IntegerLongRep xb;
+  const IntegerRep* x = Ix.GetRep(xb);
   nonnil(x);
   IntegerRep* q = Iq.rep;
   int xl = x->len;
@@ -1367,7 +1450,7 @@ void divide(const Integer& Ix, long y, Integer& Iq, long& rem)
   while (u != 0)
   {
     ys[yl++] = extract(u);
-    u = down(u);
+    u >>= I_SHIFT;
   }
 
   int comp = xl - yl;
@@ -1397,10 +1480,13 @@ void divide(const Integer& Ix, long y, Integer& Iq, long& rem)
 	 unsigned short prescale = (unsigned short) (I_RADIX / (1 + ys[yl - 1]));
     if (prescale != 1)
     {
-      unsigned long prod = (unsigned long)prescale * (unsigned long)ys[0];
-      ys[0] = extract(prod);
-      prod = down(prod) + (unsigned long)prescale * (unsigned long)ys[1];
-      ys[1] = extract(prod);
+      unsigned long prod = 0;
+      for (int i = 0; i < yl; ++i)
+      {
+        prod += (unsigned long)prescale * (unsigned long)ys[i];
+        ys[i] = extract(prod);
+        prod = down(prod);
+      }
       r = multiply(x, ((long)prescale & I_MAXNUM), r);
     }
     else
@@ -1428,15 +1514,23 @@ void divide(const Integer& Ix, long y, Integer& Iq, long& rem)
   if (xsgn == I_NEGATIVE) rem = -rem;
   q->sgn = samesign;
   Icheck(q);
-  Iq.rep = q;
+  Iq.SetRep(q);
 }
 
 
 void divide(const Integer& Ix, const Integer& Iy, Integer& Iq, Integer& Ir)
 {
-  const IntegerRep* x = Ix.rep;
+  if (!Ix.rep && !Iy.rep && Iy.m_small != 0)
+  {
+    long x = Ix.m_small, y = Iy.m_small;
+    Iq.SetSmall(x / y);
+    Ir.SetSmall(x % y);
+    return;
+  }
+  IntegerLongRep xb, yb;
+  const IntegerRep* x = Ix.GetRep(xb);
   nonnil(x);
-  const IntegerRep* y = Iy.rep;
+  const IntegerRep* y = Iy.GetRep(yb);
   nonnil(y);
   IntegerRep* q = Iq.rep;
   IntegerRep* r = Ir.rep;
@@ -1484,6 +1578,7 @@ void divide(const Integer& Ix, const Integer& Iy, Integer& Iq, Integer& Ir)
       yy = (IntegerRep*)y;
       r = Icalloc(r, xl + 1);
       scpy(x->s, r->s, xl);
+      r->sgn = xsgn;
     }
 
     int ql = xl - yl + 1;
@@ -1500,9 +1595,9 @@ void divide(const Integer& Ix, const Integer& Iy, Integer& Iq, Integer& Ir)
   }
   q->sgn = samesign;
   Icheck(q);
-  Iq.rep = q;
+  Iq.SetRep(q);
   Icheck(r);
-  Ir.rep = r;
+  Ir.SetRep(r);
 }
 
 IntegerRep* mod(const IntegerRep* x, const IntegerRep* y, IntegerRep* r)
@@ -1544,6 +1639,7 @@ IntegerRep* mod(const IntegerRep* x, const IntegerRep* y, IntegerRep* r)
       yy = (IntegerRep*)y;
       r = Icalloc(r, xl + 1);
       scpy(x->s, r->s, xl);
+      r->sgn = xsgn;
     }
       
     do_divide(r->s, yy->s, yl, 0, xl - yl + 1);
@@ -1578,7 +1674,7 @@ IntegerRep* mod(const IntegerRep* x, long y, IntegerRep* r)
   while (u != 0)
   {
     ys[yl++] = extract(u);
-    u = down(u);
+    u >>= I_SHIFT;
   }
 
   int comp = xl - yl;
@@ -1602,16 +1698,20 @@ IntegerRep* mod(const IntegerRep* x, long y, IntegerRep* r)
 	 unsigned short prescale = (unsigned short) (I_RADIX / (1 + ys[yl - 1]));
     if (prescale != 1)
     {
-      unsigned long prod = (unsigned long)prescale * (unsigned long)ys[0];
-      ys[0] = extract(prod);
-      prod = down(prod) + (unsigned long)prescale * (unsigned long)ys[1];
-      ys[1] = extract(prod);
+      unsigned long prod = 0;
+      for (int i = 0; i < yl; ++i)
+      {
+        prod += (unsigned long)prescale * (unsigned long)ys[i];
+        ys[i] = extract(prod);
+        prod = down(prod);
+      }
       r = multiply(x, ((long)prescale & I_MAXNUM), r);
     }
     else
     {
       r = Icalloc(r, xl + 1);
       scpy(x->s, r->s, xl);
+      r->sgn = xsgn;
     }
       
     do_divide(r->s, ys, yl, 0, xl - yl + 1);
@@ -1775,7 +1875,7 @@ IntegerRep* bitop(const IntegerRep* x, long y, IntegerRep* r, char op)
   while (u != 0)
   {
 	 tmp[l++] = extract(u);
-	 u = down(u);
+	 u >>= I_SHIFT;
   }
 
   int xl = x->len;
@@ -1856,11 +1956,13 @@ void (setbit)(Integer& x, long b)
   {
 	 int bw = (int) ((unsigned long)b / I_SHIFT);
 	 int sw = (int) ((unsigned long)b % I_SHIFT);
-    int xl = x.rep ? x.rep->len : 0;
+    x.Expand();
+    int xl = x.rep->len;
     if (xl <= bw)
       x.rep = Iresize(x.rep, calc_len(xl, bw+1, 0));
     x.rep->s[bw] |= (1 << sw);
     Icheck(x.rep);
+    x.SetRep(x.rep);
   }
 }
 
@@ -1868,26 +1970,25 @@ void clearbit(Integer& x, long b)
 {
   if (b >= 0)
     {
-      if (x.rep == 0)
-	x.rep = &_ZeroRep;
-      else
-	{
-	  int bw = (int) ((unsigned long)b / I_SHIFT);
-	  int sw = (int) ((unsigned long)b % I_SHIFT);
-	  if (x.rep->len > bw)
-	    x.rep->s[bw] &= ~(1 << sw);
-	}
-    Icheck(x.rep);
-  }
+      x.Expand();
+      int bw = (int) ((unsigned long)b / I_SHIFT);
+      int sw = (int) ((unsigned long)b % I_SHIFT);
+      if (x.rep->len > bw)
+	x.rep->s[bw] &= ~(1 << sw);
+      Icheck(x.rep);
+      x.SetRep(x.rep);
+    }
 }
 
 int testbit(const Integer& x, long b)
 {
-  if (x.rep != 0 && b >= 0)
+  if (b >= 0)
   {
 	 int bw = (int) ((unsigned long)b / I_SHIFT);
 	 int sw = (int) ((unsigned long)b % I_SHIFT);
-    return (bw < x.rep->len && (x.rep->s[bw] & (1 << sw)) != 0);
+    IntegerLongRep xb;
+    const IntegerRep *xrep = x.GetRep(xb);
+    return (bw < xrep->len && (xrep->s[bw] & (1 << sw)) != 0);
   }
   else
     return 0;
@@ -2196,7 +2297,8 @@ std::string Itoa(const IntegerRep *x, int base, int width)
 
 std::ostream &operator<<(std::ostream &s, const Integer &y)
 {
-  return s << Itoa(y.rep);
+  IntegerLongRep yb;
+  return s << Itoa(y.GetRep(yb));
 }
 
 std::string cvtItoa(const IntegerRep *x, std::string fmt, int& fmtlen, int base, int showbase,
@@ -2295,7 +2397,7 @@ std::istream &operator>>(std::istream &s, Integer& y)
 {
   char sgn = 0;
   char ch;
-  y.rep = Icopy_zero(y.rep);
+  y.SetSmall(0);
 
   do  {
 	 s.get(ch);
@@ -2334,7 +2436,9 @@ std::istream &operator>>(std::istream &s, Integer& y)
 
 int Integer::OK() const
 {
-  if (rep != 0)
+  if (rep == 0)
+    return m_small != LONG_MIN;
+  else if (!Iislong(rep) || Itolong(rep) == LONG_MIN)
 	 {
       int l = rep->len;
       int s = rep->sgn;
@@ -2361,178 +2465,345 @@ void Integer::error(const char* msg) const
 // The following were moved from the header file to stop BC from squealing
 // endless quantities of warnings
 
-Integer::Integer() :rep(&_ZeroRep) {}
+const IntegerRep *Integer::GetRep(IntegerLongRep &p_buffer) const
+{
+  if (rep)  return rep;
+  IntegerRep *r = reinterpret_cast<IntegerRep *>(p_buffer.m_storage);
+  unsigned long u = Magnitude(m_small);
+  r->sz = 0;      // marks the rep as static, so it is never deleted
+  r->sgn = (m_small >= 0) ? I_POSITIVE : I_NEGATIVE;
+  r->len = 0;
+  while (u != 0)
+  {
+    r->s[r->len++] = extract(u);
+    u >>= I_SHIFT;
+  }
+  return r;
+}
 
-Integer::Integer(IntegerRep* r) :rep(r) {}
+void Integer::SetRep(IntegerRep *r)
+{
+  // The IntegerRep routines have already reused or deleted the previous rep
+  if (Iislong(r) && !(r->sgn == I_NEGATIVE && Itolong(r) == LONG_MIN))
+  {
+    m_small = Itolong(r);
+    if (!STATIC_IntegerRep(r)) delete [] r;
+    rep = 0;
+  }
+  else
+    rep = r;
+}
+
+void Integer::SetSmall(long y)
+{
+  if (y == LONG_MIN)
+  {
+    rep = Icopy_ulong(rep, Magnitude(y));
+    rep->sgn = I_NEGATIVE;
+    return;
+  }
+  if (rep && !STATIC_IntegerRep(rep)) delete [] rep;
+  rep = 0;
+  m_small = y;
+}
+
+void Integer::Expand(void)
+{
+  if (!rep)  rep = Icopy_long(0, m_small);
+}
+
+Integer::Integer() : m_small(0), rep(0) {}
 
-Integer::Integer(int y) :rep(Icopy_long(0, (long)y)) {}
+Integer::Integer(IntegerRep* r) : m_small(0), rep(0) { SetRep(r); }
 
-Integer::Integer(long y) :rep(Icopy_long(0, y)) {}
+Integer::Integer(int y) : m_small(y), rep(0) {}
 
-Integer::Integer(unsigned long y) :rep(Icopy_ulong(0, y)) {}
+Integer::Integer(long y) : m_small(0), rep(0) { SetSmall(y); }
 
-Integer::Integer(const Integer&  y) :rep(Icopy(0, y.rep)) {}
+Integer::Integer(unsigned long y)
+  : m_small(0), rep((y > (unsigned long) LONG_MAX) ? Icopy_ulong(0, y) : 0)
+{
+  if (!rep)  m_small = (long) y;
+}
+
+Integer::Integer(const Integer&  y)
+  : m_small(y.m_small), rep((y.rep) ? Icopy(0, y.rep) : 0) {}
 
 Integer::~Integer() { if (rep && !STATIC_IntegerRep(rep)) delete[] rep; }
 
 Integer &Integer::operator=(const Integer &y)
 {
-  rep = Icopy(rep, y.rep);
+  if (y.rep)
+    rep = Icopy(rep, y.rep);
+  else
+    SetSmall(y.m_small);
   return *this;
 }
 
 Integer &Integer::operator=(long y)
 {
-  rep = Icopy_long(rep, y); 
+  SetSmall(y);
   return *this;
 }
 
 int Integer::initialized() const
 {
-  return rep != 0;
+  return 1;
 }
 
 // procedural versions
 
 int compare(const Integer& x, const Integer& y)
 {
+  if (!x.rep && !y.rep)
+    return (x.m_small < y.m_small) ? -1 : ((x.m_small > y.m_small) ? 1 : 0);
+  // An inline value is smaller in magnitude than any rep
+  else if (!x.rep)
+    return (y.rep->sgn == I_POSITIVE) ? -1 : 1;
+  else if (!y.rep)
+    return (x.rep->sgn == I_POSITIVE) ? 1 : -1;
   return compare(x.rep, y.rep);
 }
 
 int ucompare(const Integer& x, const Integer& y)
 {
+  if (!x.rep && !y.rep)
+  {
+    unsigned long ux = Magnitude(x.m_small), uy = Magnitude(y.m_small);
+    return (ux < uy) ? -1 : ((ux > uy) ? 1 : 0);
+  }
+  else if (!x.rep)
+    return -1;
+  else if (!y.rep)
+    return 1;
   return ucompare(x.rep, y.rep);
 }
 
 int compare(const Integer& x, long y)
 {
+  if (!x.rep)
+    return (x.m_small < y) ? -1 : ((x.m_small > y) ? 1 : 0);
   return compare(x.rep, y);
 }
 
 int ucompare(const Integer& x, long y)
 {
+  if (!x.rep)
+  {
+    unsigned long ux = Magnitude(x.m_small), uy = Magnitude(y);
+    return (ux < uy) ? -1 : ((ux > uy) ? 1 : 0);
+  }
   return ucompare(x.rep, y);
 }
 
 int compare(long x, const Integer& y)
 {
-  return -compare(y.rep, x);
+  return -compare(y, x);
 }
 
 int ucompare(long x, const Integer& y)
 {
-  return -ucompare(y.rep, x);
+  return -ucompare(y, x);
 }
 
 void  add(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = add(x.rep, 0, y.rep, 0, dest.rep);
+  long r;
+  if (!x.rep && !y.rep && !AddOverflows(x.m_small, y.m_small, r))
+  {
+    dest.SetSmall(r);
+    return;
+  }
+  IntegerLongRep xb, yb;
+  dest.SetRep(add(x.GetRep(xb), 0, y.GetRep(yb), 0, dest.rep));
 }
 
 void  sub(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = add(x.rep, 0, y.rep, 1, dest.rep);
+  long r;
+  if (!x.rep && !y.rep && !SubOverflows(x.m_small, y.m_small, r))
+  {
+    dest.SetSmall(r);
+    return;
+  }
+  IntegerLongRep xb, yb;
+  dest.SetRep(add(x.GetRep(xb), 0, y.GetRep(yb), 1, dest.rep));
 }
 
 void  mul(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = multiply(x.rep, y.rep, dest.rep);
+  long r;
+  if (!x.rep && !y.rep && !MulOverflows(x.m_small, y.m_small, r))
+  {
+    dest.SetSmall(r);
+    return;
+  }
+  IntegerLongRep xb, yb;
+  dest.SetRep(multiply(x.GetRep(xb), y.GetRep(yb), dest.rep));
 }
 
 void  div(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = div(x.rep, y.rep, dest.rep);
+  // Division by zero is left to the rep routine, which throws
+  if (!x.rep && !y.rep && y.m_small != 0)
+  {
+    dest.SetSmall(x.m_small / y.m_small);
+    return;
+  }
+  IntegerLongRep xb, yb;
+  dest.SetRep(div(x.GetRep(xb), y.GetRep(yb), dest.rep));
 }
 
 void  mod(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = mod(x.rep, y.rep, dest.rep);
+  if (!x.rep && !y.rep && y.m_small != 0)
+  {
+    dest.SetSmall(x.m_small % y.m_small);
+    return;
+  }
+  IntegerLongRep xb, yb;
+  dest.SetRep(mod(x.GetRep(xb), y.GetRep(yb), dest.rep));
 }
 
 void  lshift(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = lshift(x.rep, y.rep, 0, dest.rep);
+  IntegerLongRep xb, yb;
+  dest.SetRep(lshift(x.GetRep(xb), y.GetRep(yb), 0, dest.rep));
 }
 
 void  rshift(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = lshift(x.rep, y.rep, 1, dest.rep);
+  IntegerLongRep xb, yb;
+  dest.SetRep(lshift(x.GetRep(xb), y.GetRep(yb), 1, dest.rep));
 }
 
 void  pow(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = power(x.rep, Itolong(y.rep), dest.rep); // not incorrect
+  IntegerLongRep xb;
+  dest.SetRep(power(x.GetRep(xb), y.as_long(), dest.rep)); // not incorrect
 }
 
 void  add(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = add(x.rep, 0, y, dest.rep);
+  long r;
+  if (!x.rep && y != LONG_MIN && !AddOverflows(x.m_small, y, r))
+  {
+    dest.SetSmall(r);
+    return;
+  }
+  IntegerLongRep xb;
+  dest.SetRep(add(x.GetRep(xb), 0, y, dest.rep));
 }
 
 void  sub(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = add(x.rep, 0, -y, dest.rep);
+  if (y == LONG_MIN)
+  {
+    sub(x, Integer(y), dest);
+    return;
+  }
+  add(x, -y, dest);
 }
 
 void  mul(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = multiply(x.rep, y, dest.rep);
+  long r;
+  if (!x.rep && y != LONG_MIN && !MulOverflows(x.m_small, y, r))
+  {
+    dest.SetSmall(r);
+    return;
+  }
+  IntegerLongRep xb;
+  dest.SetRep(multiply(x.GetRep(xb), y, dest.rep));
 }
 
 void  div(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = div(x.rep, y, dest.rep);
+  if (!x.rep && y != LONG_MIN && y != 0)
+  {
+    dest.SetSmall(x.m_small / y);
+    return;
+  }
+  IntegerLongRep xb;
+  dest.SetRep(div(x.GetRep(xb), y, dest.rep));
 }
 
 void  mod(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = mod(x.rep, y, dest.rep);
+  if (!x.rep && y != LONG_MIN && y != 0)
+  {
+    dest.SetSmall(x.m_small % y);
+    return;
+  }
+  IntegerLongRep xb;
+  dest.SetRep(mod(x.GetRep(xb), y, dest.rep));
 }
 
 
 void  lshift(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = lshift(x.rep, y, dest.rep);
+  IntegerLongRep xb;
+  dest.SetRep(lshift(x.GetRep(xb), y, dest.rep));
 }
 
 void  rshift(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = lshift(x.rep, -y, dest.rep);
+  IntegerLongRep xb;
+  dest.SetRep(lshift(x.GetRep(xb), -y, dest.rep));
 }
 
 void  pow(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = power(x.rep, y, dest.rep);
+  IntegerLongRep xb;
+  dest.SetRep(power(x.GetRep(xb), y, dest.rep));
 }
 
 void abs(const Integer& x, Integer& dest)
 {
-  dest.rep = abs(x.rep, dest.rep);
+  if (!x.rep)
+  {
+    dest.SetSmall((x.m_small < 0) ? -x.m_small : x.m_small);
+    return;
+  }
+  dest.SetRep(abs(x.rep, dest.rep));
 }
 
 void negate(const Integer& x, Integer& dest)
 {
-  dest.rep = negate(x.rep, dest.rep);
+  if (!x.rep)
+  {
+    dest.SetSmall(-x.m_small);
+    return;
+  }
+  dest.SetRep(negate(x.rep, dest.rep));
 }
 
 void complement(const Integer& x, Integer& dest)
 {
-  dest.rep = Compl(x.rep, dest.rep);
+  IntegerLongRep xb;
+  dest.SetRep(Compl(x.GetRep(xb), dest.rep));
 }
 
 void  add(long x, const Integer& y, Integer& dest)
 {
-  dest.rep = add(y.rep, 0, x, dest.rep);
+  add(y, x, dest);
 }
 
 void  sub(long x, const Integer& y, Integer& dest)
 {
-  dest.rep = add(y.rep, 1, x, dest.rep);
+  long r;
+  if (!y.rep && x != LONG_MIN && !SubOverflows(x, y.m_small, r))
+  {
+    dest.SetSmall(r);
+    return;
+  }
+  IntegerLongRep yb;
+  dest.SetRep(add(y.GetRep(yb), 1, x, dest.rep));
 }
 
 void  mul(long x, const Integer& y, Integer& dest)
 {
-  dest.rep = multiply(y.rep, x, dest.rep);
+  mul(y, x, dest);
 }
 
 // operator versions
@@ -2698,29 +2969,37 @@ void Integer::negate()
 
 int sign(const Integer& x)
 {
+  if (!x.rep)
+    return (x.m_small > 0) ? 1 : ((x.m_small < 0) ? -1 : 0);
   return (x.rep->len == 0) ? 0 : ( (x.rep->sgn == 1) ? 1 : -1 );
 }
 
 int even(const Integer& y)
 {
+  if (!y.rep)
+    return y.m_small % 2 == 0;
   return y.rep->len == 0 || !(y.rep->s[0] & 1);
 }
 
 int odd(const Integer& y)
 {
+  if (!y.rep)
+    return y.m_small % 2 != 0;
   return y.rep->len > 0 && (y.rep->s[0] & 1);
 }
 
 std::string Itoa(const Integer& y, int base, int width)
 {
-  return Itoa(y.rep, base, width);
+  IntegerLongRep yb;
+  return Itoa(y.GetRep(yb), base, width);
 }
 
 
 
 long lg(const Integer& x) 
 {
-  return lg(x.rep);
+  IntegerLongRep xb;
+  return lg(x.GetRep(xb));
 }
 
 // constructive operations 
@@ -2871,14 +3150,27 @@ Integer Integer::operator-(void) const
 Integer  atoI(const char* s, int base) 
 {
   Integer r;
-  r.rep = atoIntegerRep(s, base);
+  r.SetRep(atoIntegerRep(s, base));
   return r;
 }
 
 Integer  gcd(const Integer& x, const Integer& y)
 {
   Integer r;
-  r.rep = gcd(x.rep, y.rep);
+  if (!x.rep && !y.rep)
+  {
+    unsigned long u = Magnitude(x.m_small), v = Magnitude(y.m_small);
+    while (v != 0)
+    {
+      unsigned long t = u % v;
+      u = v;
+      v = t;
+    }
+    r.m_small = (long) u;
+    return r;
+  }
+  IntegerLongRep xb, yb;
+  r.SetRep(gcd(x.GetRep(xb), y.GetRep(yb)));
   return r;
 }
 
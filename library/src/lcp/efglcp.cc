@@ -24,47 +24,105 @@
 #include <cstdio>
 #include <unistd.h>
 #include <iostream>
+#include <algorithm>
+#include <exception>
+#include <unordered_set>
 #include "gambit/gambit.h"
 #include "gambit/linalg/lemketab.h"
 #include "gambit/linalg/lhtab.h"
 #include "gambit/nash/lcp.h"
+#include "lemkepath.h"
 
 namespace Gambit {
 namespace Nash {
 
+namespace {
+
+template <class T> 
+linalg::BFS<T> GetBFS(const linalg::LemkeTableau<T> &tableau)
+{
+  Gambit::linalg::BFS<T> cbfs;
+  Vector<T> v(tableau.MinRow(), tableau.MaxRow());
+  tableau.BasisVector(v);
+
+  for (int i = tableau.MinCol(); i <= tableau.MaxCol(); i++) {
+    if (tableau.Member(i)) {
+      cbfs.insert(i, v[tableau.Find(i)]);
+    }
+  }
+  return cbfs;
+}
+
+}  // end anonymous namespace
+
 template <class T> class NashLcpBehaviorSolver<T>::Solution {
 public:
+  SequenceForm sf;
   int ns1, ns2, ni1, ni2;
   Rational maxpay;
   T eps;
-  List<GameInfoset> isets1, isets2;
-  List<Gambit::linalg::BFS<T> > m_list;
+  std::unordered_set<Gambit::linalg::BFS<T>,
+		     Gambit::linalg::BFSHash<T> > m_bfsSet;
   List<MixedBehaviorProfile<T> > m_equilibria;
 
-  bool AddBFS(const linalg::LemkeTableau<T> &);
+  Solution(const BehaviorSupportProfile &p_support) : sf(p_support) { }
+
+  /// Adds the CBFS, returning true if it had not been found before
+  bool AddBFS(const linalg::BFS<T> &p_bfs)
+  { return m_bfsSet.insert(p_bfs).second; }
 
   int EquilibriumCount(void) const { return m_equilibria.size(); }
 };
 
-template <class T> bool 
-NashLcpBehaviorSolver<T>::Solution::AddBFS(const linalg::LemkeTableau<T> &tableau)
+//
+// The path from a CBFS after the covering vector is perturbed in row
+// m_row.  It is followed on copies of the tableau and of the matrix;
+// when paths are followed in several threads, the copy of the
+// tableau is made independent of the original.
+//
+template <class T> class NashLcpBehaviorSolver<T>::Path {
+public:
+  int m_row, m_start, m_depth;
+  Matrix<T> m_A;
+  linalg::LemkeTableau<T> m_tableau;
+  bool m_complete;
+  linalg::BFS<T> m_bfs;
+  std::exception_ptr m_error;
+
+  Path(const linalg::LemkeTableau<T> &p_tableau, const Matrix<T> &p_A,
+       int p_row, int p_start, int p_depth, bool p_detach)
+    : m_row(p_row), m_start(p_start), m_depth(p_depth),
+      m_A(p_A), m_tableau(p_tableau), m_complete(false)
+  {
+    if (p_detach)  m_tableau.Detach();
+    m_A(m_row, 0) = -(T) 1 / (T) 1000;
+    m_tableau.Set_A(m_A);
+  }
+
+  void Follow(void);
+};
+
+template <class T> void NashLcpBehaviorSolver<T>::Path::Follow(void)
 {
-  Gambit::linalg::BFS<T> cbfs;
-  Vector<T> v(tableau.MinRow(), tableau.MaxRow());
-  tableau.BasisVector(v);
+  try {
+    m_tableau.Refactor();
 
-  for (int i = tableau.MinCol(); i <= tableau.MaxCol(); i++) {
-    if (tableau.Member(i)) {
-      cbfs.insert(i, v[tableau.Find(i)]);
+    int missing;
+    if (m_depth == 0) {
+      m_tableau.Pivot(m_start, 0);
+      missing = -m_start;
+    }
+    else {
+      missing = m_tableau.SF_PivotIn(0);
     }
-  }
 
-  if (!m_list.Contains(cbfs)) {
-    m_list.push_back(cbfs);
-    return true;
+    if (m_tableau.SF_LCPPath(-missing) == 1) {
+      m_complete = true;
+      m_bfs = GetBFS(m_tableau);
+    }
   }
-  else {
-    return false;
+  catch (...) {
+    m_error = std::current_exception();
   }
 }
 
@@ -86,14 +144,11 @@ NashLcpBehaviorSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
 
   Gambit::linalg::BFS<T> cbfs;
   int i, j;
-  Solution solution;
-
-  solution.isets1 = p_support.ReachableInfosets(p_support.GetGame()->GetPlayer(1));
-  solution.isets2 = p_support.ReachableInfosets(p_support.GetGame()->GetPlayer(2));
+  Solution solution(p_support);
 
   int ntot;
-  solution.ns1 = p_support.NumSequences(1);
-  solution.ns2 = p_support.NumSequences(2);
+  solution.ns1 = solution.sf.NumSequences(1);
+  solution.ns2 = solution.sf.NumSequences(2);
   solution.ni1 = p_support.GetGame()->GetPlayer(1)->NumInfosets()+1;
   solution.ni2 = p_support.GetGame()->GetPlayer(2)->NumInfosets()+1;
 
@@ -104,7 +159,6 @@ NashLcpBehaviorSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
 
   solution.maxpay = p_support.GetGame()->GetMaxPayoff() + Rational(1);
 
-  T prob = (T)1;
   for (i = A.MinRow(); i <= A.MaxRow(); i++) {
     b[i] = (T) 0;
     for (j = A.MinCol(); j <= A.MaxCol(); j++) {
@@ -112,8 +166,7 @@ NashLcpBehaviorSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
     }
   }
 
-  FillTableau(p_support, A, p_support.GetGame()->GetRoot(), prob, 1, 1, 0, 0,
-	      solution);
+  FillTableau(A, solution);
   for (i = A.MinRow(); i <= A.MaxRow(); i++) { 
     A(i,0) = -(T) 1;
   }
@@ -145,11 +198,9 @@ NashLcpBehaviorSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
       tab.Pivot(solution.ns1+solution.ns2+1,0);
       tab.SF_LCPPath(solution.ns1+solution.ns2+1);
       
-      solution.AddBFS(tab);
+      solution.AddBFS(GetBFS(tab));
       tab.BasisVector(sol);
-      GetProfile(p_support, tab, 
-		 profile,sol,p_support.GetGame()->GetRoot(), 1, 1,
-		 solution);
+      GetProfile(tab, profile, sol, solution);
       profile.UndefinedToCentroid();
       solution.m_equilibria.push_back(profile);
       this->m_onEquilibrium->Render(profile);
@@ -168,200 +219,142 @@ NashLcpBehaviorSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
 // for the equilibria that have already been found.  
 // From each new accessible equilibrium, it follows
 // all possible paths, adding any new equilibria to the List.  
+// Paths are followed in batches of one per thread; the batch is
+// then scanned in order for the first path to a new equilibrium,
+// so the search goes just as if they were followed one at a time.
 //
 template <class T> void
 NashLcpBehaviorSolver<T>::AllLemke(const BehaviorSupportProfile &p_support,
 				   int j, linalg::LemkeTableau<T> &B, int depth,
-				   Matrix<T> &A,
+				   const Matrix<T> &A,
 				   Solution &p_solution) const
 {
   if (m_maxDepth != 0 && depth > m_maxDepth) {
     return;
   }
 
-  T small_num = (T)1/(T)1000;
-
-  Vector<T> sol(B.MinRow(),B.MaxRow());
-  MixedBehaviorProfile<T> profile(p_support);
-
-  bool newsol = false;
-  for (int i = B.MinRow(); i <= B.MaxRow() && !newsol; i++) {
-    if (i == j) continue;
-
-    linalg::LemkeTableau<T> BCopy(B);
-    A(i,0) = -small_num;
-    BCopy.Refactor();
-
-    int missing;
-    if (depth == 0) {
-      BCopy.Pivot(j, 0);
-      missing = -j;
-    }
-    else {
-      missing = BCopy.SF_PivotIn(0);
-    }
+  int batch = std::max(m_numThreads, 1);
+  for (int first = B.MinRow(); first <= B.MaxRow(); first += batch) {
+    std::vector<Path *> paths;
+    try {
+      for (int i = first; i < first + batch && i <= B.MaxRow(); i++) {
+	if (i != j)  paths.push_back(new Path(B, A, i, j, depth,
+						m_numThreads > 1));
+      }
+      FollowPaths(paths, m_numThreads);
 
-    newsol = false;
+      for (size_t k = 0; k < paths.size(); k++) {
+	Path &path = *paths[k];
+	if (path.m_error) {
+	  std::rethrow_exception(path.m_error);
+	}
+	if (!path.m_complete || !p_solution.AddBFS(path.m_bfs)) {
+	  continue;
+	}
 
-    if (BCopy.SF_LCPPath(-missing) == 1) {
-      newsol = p_solution.AddBFS(BCopy);
-      BCopy.BasisVector(sol);
-      GetProfile(p_support, BCopy, profile, sol,
-		 p_support.GetGame()->GetRoot(), 1, 1,
-		 p_solution);
-      profile.UndefinedToCentroid();
-      if (newsol) {
+	Vector<T> sol(B.MinRow(), B.MaxRow());
+	MixedBehaviorProfile<T> profile(p_support);
+	path.m_tableau.BasisVector(sol);
+	GetProfile(path.m_tableau, profile, sol, p_solution);
+	profile.UndefinedToCentroid();
 	this->m_onEquilibrium->Render(profile);
 	p_solution.m_equilibria.push_back(profile);
 	if (m_stopAfter > 0 && p_solution.EquilibriumCount() >= m_stopAfter) {
 	  throw EquilibriumLimitReached();
 	}
+
+	path.m_A(path.m_row, 0) = (T) -1;
+	path.m_tableau.Refactor();
+	AllLemke(p_support, path.m_row, path.m_tableau, depth+1, path.m_A,
+		 p_solution);
+	for (size_t i = 0; i < paths.size(); delete paths[i++]);
+	return;
       }
     }
-    else {
-      // gout << ": Dead End";
-    }
-      
-    A(i,0) = (T) -1;
-    if (newsol) {
-      BCopy.Refactor();
-      AllLemke(p_support, i, BCopy, depth+1, A, p_solution);
+    catch (...) {
+      for (size_t i = 0; i < paths.size(); delete paths[i++]);
+      throw;
     }
+    for (size_t i = 0; i < paths.size(); delete paths[i++]);
   }
 }
 
+//
+// Fills in the payoffs and constraints of the sequence form in the
+// tableau.  Payoffs are shifted to be negative, by subtracting the
+// largest payoff (plus one) from each outcome.
+//
 template <class T>
-void NashLcpBehaviorSolver<T>::FillTableau(const BehaviorSupportProfile &p_support, 
-					Matrix<T> &A,
-					const GameNode &n, T prob,
-					int s1, int s2, int i1, int i2,
-					Solution &p_solution) const
+void NashLcpBehaviorSolver<T>::FillTableau(Matrix<T> &A,
+					   const Solution &p_solution) const
 {
-  int snew;
+  const SequenceForm &sf = p_solution.sf;
   int ns1 = p_solution.ns1;
   int ns2 = p_solution.ns2;
   int ni1 = p_solution.ni1;
 
-  GameOutcome outcome = n->GetOutcome();
-  if (outcome) {
-    A(s1,ns1+s2) = Rational(A(s1,ns1+s2)) +
-      Rational(prob) * (outcome->GetPayoff<Rational>(1) - p_solution.maxpay);
-    A(ns1+s2,s1) = Rational(A(ns1+s2,s1)) +
-      Rational(prob) * (outcome->GetPayoff<Rational>(2) - p_solution.maxpay);
+  for (int e = 1; e <= sf.NumEntries(); e++) {
+    int s1 = sf.GetEntrySequence(e, 1), s2 = sf.GetEntrySequence(e, 2);
+    Rational shift = sf.GetEntryProb(e) * p_solution.maxpay;
+    A(s1,ns1+s2) = sf.GetEntryPayoff(e, 1) - shift;
+    A(ns1+s2,s1) = sf.GetEntryPayoff(e, 2) - shift;
   }
-  if (n->GetInfoset()) {
-    if (n->GetPlayer()->IsChance()) {
-      GameInfoset infoset = n->GetInfoset();
-      for (int i = 1; i <= n->NumChildren(); i++) {
-	FillTableau(p_support, A, n->GetChild(i),
-		    Rational(prob) * infoset->GetActionProb(i, Rational(0)),
-		    s1, s2, i1, i2, p_solution);
-      }
-    }
-    int pl = n->GetPlayer()->GetNumber();
-    if (pl==1) {
-      i1=p_solution.isets1.Find(n->GetInfoset());
-      snew=1;
-      for (int i = 1; i < i1; i++) {
-	snew+=p_support.NumActions(p_solution.isets1[i]->GetPlayer()->GetNumber(),
-				   p_solution.isets1[i]->GetNumber());
-      }
-      A(s1,ns1+ns2+i1+1) = -(T)1;
-      A(ns1+ns2+i1+1,s1) = (T)1;
-      for (int i = 1; i <= p_support.NumActions(n->GetInfoset()->GetPlayer()->GetNumber(), n->GetInfoset()->GetNumber()); i++) {
-	A(snew+i,ns1+ns2+i1+1) = (T)1;
-	A(ns1+ns2+i1+1,snew+i) = -(T)1;
-	FillTableau(p_support, A, n->GetChild(p_support.GetAction(n->GetInfoset()->GetPlayer()->GetNumber(), n->GetInfoset()->GetNumber(), i)->GetNumber()),prob,snew+i,s2,i1,i2, p_solution);
-      }
+
+  for (int i1 = 1; i1 <= sf.NumInfosets(1); i1++) {
+    int s1 = sf.GetParentSequence(1, i1);
+    A(s1,ns1+ns2+i1+1) = -(T)1;
+    A(ns1+ns2+i1+1,s1) = (T)1;
+    for (int i = 1; i <= sf.GetSupport().NumActions(sf.GetInfoset(1, i1)); i++) {
+      int snew = sf.GetSequence(1, i1, i);
+      A(snew,ns1+ns2+i1+1) = (T)1;
+      A(ns1+ns2+i1+1,snew) = -(T)1;
     }
-    if(pl==2) {
-      i2=p_solution.isets2.Find(n->GetInfoset());
-      snew=1;
-      for (int i = 1; i < i2; i++) {
-	snew+=p_support.NumActions(p_solution.isets2[i]->GetPlayer()->GetNumber(),
-				   p_solution.isets2[i]->GetNumber());
-      }
-      A(ns1+s2,ns1+ns2+ni1+i2+1) = -(T)1;
-      A(ns1+ns2+ni1+i2+1,ns1+s2) = (T)1;
-      for (int i = 1; i <= p_support.NumActions(n->GetInfoset()->GetPlayer()->GetNumber(), n->GetInfoset()->GetNumber()); i++) {
-	A(ns1+snew+i,ns1+ns2+ni1+i2+1) = (T)1;
-	A(ns1+ns2+ni1+i2+1,ns1+snew+i) = -(T)1;
-	FillTableau(p_support, A, n->GetChild(p_support.GetAction(n->GetInfoset()->GetPlayer()->GetNumber(), n->GetInfoset()->GetNumber(), i)->GetNumber()),prob,s1,snew+i,i1,i2, p_solution);
-      }
+  }
+
+  for (int i2 = 1; i2 <= sf.NumInfosets(2); i2++) {
+    int s2 = sf.GetParentSequence(2, i2);
+    A(ns1+s2,ns1+ns2+ni1+i2+1) = -(T)1;
+    A(ns1+ns2+ni1+i2+1,ns1+s2) = (T)1;
+    for (int i = 1; i <= sf.GetSupport().NumActions(sf.GetInfoset(2, i2)); i++) {
+      int snew = sf.GetSequence(2, i2, i);
+      A(ns1+snew,ns1+ns2+ni1+i2+1) = (T)1;
+      A(ns1+ns2+ni1+i2+1,ns1+snew) = -(T)1;
     }
-    
   }
 }
 
-
+//
+// Recovers the behavior profile from the solution of the tableau; the
+// probability of each action is that of the sequence ending with it,
+// relative to that of the sequence leading to its information set.
+//
 template <class T> void
-NashLcpBehaviorSolver<T>::GetProfile(const BehaviorSupportProfile &p_support,
-				     const linalg::LemkeTableau<T> &tab, 
+NashLcpBehaviorSolver<T>::GetProfile(const linalg::LemkeTableau<T> &tab, 
 				     MixedBehaviorProfile<T> &v, 
 				     const Vector<T> &sol,
-				     const GameNode &n, int s1, int s2,
-				     Solution &p_solution) const
+				     const Solution &p_solution) const
 {
-  int ns1 = p_solution.ns1;
-
-  if (n->GetInfoset()) {
-    int pl = n->GetPlayer()->GetNumber();
-    int iset = n->GetInfoset()->GetNumber();
-
-    if (n->GetPlayer()->IsChance()) {
-      for (int i = 1; i <= n->NumChildren(); i++) {
-	GetProfile(p_support, tab, v, sol, n->GetChild(i), s1, s2,
-		   p_solution);
-      }
-    }
-    else if (pl == 1) {
-      int inf = p_solution.isets1.Find(n->GetInfoset());
-      int snew = 1;
-      for (int i = 1; i < inf; i++) {
-	snew += p_support.NumActions(1, p_solution.isets1[i]->GetNumber()); 
-      }
-      
-      for (int i = 1; i <= p_support.NumActions(pl, iset); i++) {
-	v(pl,inf,i) = (T) 0;
-	if (tab.Member(s1)) {
-	  int ind = tab.Find(s1);
-	  if (sol[ind] > p_solution.eps) {
-	    if (tab.Member(snew+i)) {
-	      int ind2 = tab.Find(snew+i);
-	      if (sol[ind2] > p_solution.eps) {
-		v(pl,inf,i) = sol[ind2] / sol[ind];
-	      }
-	    }
-	  } 
-	} 
-	GetProfile(p_support, tab, v, sol,
-		   n->GetChild(p_support.GetAction(pl, iset, i)->GetNumber()),
-		   snew+i, s2, p_solution);
-      }
-    }
-    else if (pl == 2) { 
-      int inf = p_solution.isets2.Find(n->GetInfoset());
-      int snew = 1;
-      for (int i = 1; i < inf; i++) {
-	snew += p_support.NumActions(2, p_solution.isets2[i]->GetNumber()); 
-      }
-
-      for (int i = 1; i<= p_support.NumActions(pl, iset); i++) {
-	v(pl,inf,i) = (T) 0;
-	if (tab.Member(ns1+s2)) {
-	  int ind = tab.Find(ns1+s2);
+  const SequenceForm &sf = p_solution.sf;
+  for (int pl = 1; pl <= 2; pl++) {
+    // Sequences of player 2 follow those of player 1 in the tableau
+    int offset = (pl == 1) ? 0 : p_solution.ns1;
+    for (int inf = 1; inf <= sf.NumInfosets(pl); inf++) {
+      GameInfoset infoset = sf.GetInfoset(pl, inf);
+      int s = offset + sf.GetParentSequence(pl, inf);
+      for (int i = 1; i <= sf.GetSupport().NumActions(infoset); i++) {
+	v(pl,infoset->GetNumber(),i) = (T) 0;
+	if (tab.Member(s)) {
+	  int ind = tab.Find(s);
 	  if (sol[ind] > p_solution.eps) {
-	    if (tab.Member(ns1+snew+i)) {
-	      int ind2 = tab.Find(ns1+snew+i);
+	    int snew = offset + sf.GetSequence(pl, inf, i);
+	    if (tab.Member(snew)) {
+	      int ind2 = tab.Find(snew);
 	      if (sol[ind2] > p_solution.eps) {
-		v(pl,inf,i) = sol[ind2] / sol[ind];
+		v(pl,infoset->GetNumber(),i) = sol[ind2] / sol[ind];
 	      }
 	    }
 	  } 
 	} 
-	GetProfile(p_support, tab, v, sol,
-		   n->GetChild(p_support.GetAction(pl, iset, i)->GetNumber()),
-		   s1, snew+i, p_solution);
       }
     }
   }
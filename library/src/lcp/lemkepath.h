@@ -0,0 +1,65 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/src/lcp/lemkepath.h
+// Following several Lemke paths at once
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef GAMBIT_LCP_LEMKEPATH_H
+#define GAMBIT_LCP_LEMKEPATH_H
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace Gambit {
+namespace Nash {
+
+//
+// Calls Follow() on each of the paths, sharing them out in order
+// among p_numThreads threads.  Each path works on its own tableau,
+// and keeps any exception it raises to itself.
+//
+template <class Path>
+void FollowPaths(const std::vector<Path *> &p_paths, int p_numThreads)
+{
+  class Worker {
+  public:
+    static void Run(const std::vector<Path *> *p_paths, std::atomic<int> *p_next)
+    {
+      for (int i = (*p_next)++; i < (int) p_paths->size(); i = (*p_next)++) {
+	(*p_paths)[i]->Follow();
+      }
+    }
+  };
+
+  std::atomic<int> next(0);
+  std::vector<std::thread> threads;
+  for (int i = 1; i < p_numThreads && i < (int) p_paths.size(); i++) {
+    threads.push_back(std::thread(Worker::Run, &p_paths, &next));
+  }
+  Worker::Run(&p_paths, &next);
+  for (size_t i = 0; i < threads.size(); i++) {
+    threads[i].join();
+  }
+}
+
+}  // end namespace Gambit::Nash
+}  // end namespace Gambit
+
+#endif  // GAMBIT_LCP_LEMKEPATH_H
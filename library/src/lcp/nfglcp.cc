@@ -23,10 +23,14 @@
 #include <cstdio>
 #include <unistd.h>
 #include <iostream>
+#include <algorithm>
+#include <exception>
+#include <unordered_set>
 
 #include "gambit/gambit.h"
 #include "gambit/linalg/lhtab.h"
 #include "gambit/nash/lcp.h"
+#include "lemkepath.h"
 
 namespace Gambit {
 namespace Nash {
@@ -118,30 +122,58 @@ template <class T> Vector<T> Make_b2(const Game &p_game)
 template <class T>
 class NashLcpStrategySolver<T>::Solution {
 public:
-  List<Gambit::linalg::BFS<T> > m_bfsList;
+  std::unordered_set<Gambit::linalg::BFS<T>,
+		     Gambit::linalg::BFSHash<T> > m_bfsSet;
   List<MixedStrategyProfile<T> > m_equilibria;
 
   bool Contains(const Gambit::linalg::BFS<T> &p_bfs) const
-  { return m_bfsList.Contains(p_bfs); }
+  { return m_bfsSet.count(p_bfs) > 0; }
   void push_back(const Gambit::linalg::BFS<T> &p_bfs)
-  { m_bfsList.push_back(p_bfs); }
+  { m_bfsSet.insert(p_bfs); }
 
   int EquilibriumCount(void) const { return m_equilibria.size(); }
 };
+
+//
+// The path from a CBFS along which the variable p_label enters the
+// basis.  It is followed on a copy of the tableau; when paths are
+// followed in several threads, the copy is made independent of the
+// original.
+//
+template <class T>
+class NashLcpStrategySolver<T>::Path {
+public:
+  int m_label;
+  linalg::LHTableau<T> m_tableau;
+  std::exception_ptr m_error;
+
+  Path(const linalg::LHTableau<T> &p_tableau, int p_label, bool p_detach)
+    : m_label(p_label), m_tableau(p_tableau)
+  { if (p_detach)  m_tableau.Detach(); }
+
+  void Follow(void)
+  {
+    try {
+      m_tableau.LemkePath(m_label);
+    }
+    catch (...) {
+      m_error = std::current_exception();
+    }
+  }
+};
   
 //
 // Function called when a CBFS is encountered.
-// If it is not already in the list p_list, it is added.
+// If it is not already in the set of CBFSs found, it is added.
 // The corresponding equilibrium is computed and output.
 // Returns 'true' if the CBFS is new; 'false' if it already appears in the
-// list.
+// set.
 //
 template <class T> bool
 NashLcpStrategySolver<T>::OnBFS(const Game &p_game,
-				linalg::LHTableau<T> &p_tableau,
+				const linalg::BFS<T> &cbfs,
 				Solution &p_solution) const
 {
-  Gambit::linalg::BFS<T> cbfs(p_tableau.GetBFS());
   if (p_solution.Contains(cbfs)) {
     return false;
   }
@@ -197,10 +229,13 @@ NashLcpStrategySolver<T>::OnBFS(const Game &p_game,
 
 //
 // AllLemke finds all accessible Nash equilibria by recursively 
-// calling itself.  p_list maintains the list of basic variables 
+// calling itself.  p_solution maintains the set of bases 
 // for the equilibria that have already been found.  
 // From each new accessible equilibrium, it follows
-// all possible paths, adding any new equilibria to the List.  
+// all possible paths, adding any new equilibria to the set.  
+// Paths are followed in batches of one per thread; their ends are
+// then visited in order, so the search goes just as if they were
+// followed one at a time.
 //
 template <class T> void 
 NashLcpStrategySolver<T>::AllLemke(const Game &p_game,
@@ -214,15 +249,36 @@ NashLcpStrategySolver<T>::AllLemke(const Game &p_game,
 
   // On the initial depth=0 call, the CBFS we are at is the extraneous
   // solution.
-  if (depth > 0 && !OnBFS(p_game, B, p_solution)) {
+  if (depth > 0 && !OnBFS(p_game, B.GetBFS(), p_solution)) {
     return;
   }
-  
-  for (int i = B.MinCol(); i <= B.MaxCol(); i++) {
-    if (i != j)  {
-      linalg::LHTableau<T> Bcopy(B);
-      Bcopy.LemkePath(i);
-      AllLemke(p_game, i, Bcopy, p_solution, depth+1);
+  if (m_maxDepth != 0 && depth + 1 > m_maxDepth) {
+    // The ends of the paths would not be visited
+    return;
+  }
+
+  int batch = std::max(m_numThreads, 1);
+  for (int first = B.MinCol(); first <= B.MaxCol(); first += batch) {
+    std::vector<Path *> paths;
+    try {
+      for (int i = first; i < first + batch && i <= B.MaxCol(); i++) {
+	if (i != j)  paths.push_back(new Path(B, i, m_numThreads > 1));
+      }
+      FollowPaths(paths, m_numThreads);
+
+      for (size_t k = 0; k < paths.size(); k++) {
+	if (paths[k]->m_error) {
+	  std::rethrow_exception(paths[k]->m_error);
+	}
+	AllLemke(p_game, paths[k]->m_label, paths[k]->m_tableau,
+		 p_solution, depth+1);
+	delete paths[k];
+	paths[k] = 0;
+      }
+    }
+    catch (...) {
+      for (size_t k = 0; k < paths.size(); delete paths[k++]);
+      throw;
     }
   }
 }
@@ -250,7 +306,7 @@ NashLcpStrategySolver<T>::Solve(const Game &p_game) const
     }
     else  {
       B.LemkePath(1);
-      OnBFS(p_game, B, solution);
+      OnBFS(p_game, B.GetBFS(), solution);
     }
   }
   catch (EquilibriumLimitReached &) {
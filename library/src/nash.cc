@@ -209,11 +209,7 @@ template <class T> List<MixedBehaviorProfile<T> >
 BehavViaStrategySolver<T>::Solve(const BehaviorSupportProfile &p_support) const
 {
   List<MixedStrategyProfile<T> > output = m_solver->Solve(p_support.GetGame());
-  List<MixedBehaviorProfile<T> > solutions;
-  for (int i = 1; i <= output.Length(); i++) {
-    solutions.push_back(MixedBehaviorProfile<T>(output[i]));
-  }
-  return solutions;
+  return MixedBehaviorProfile<T>::FromMixedProfiles(output);
 }
 
 
@@ -0,0 +1,334 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/number.cc
+// Implementation of compact payoff storage
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <cctype>
+
+#include "gambit/gambit.h"
+#include "gambit/binfile.h"
+
+namespace Gambit {
+
+//========================================================================
+//                          class PayoffTable
+//========================================================================
+
+//------------------------------------------------------------------------
+//                         PayoffTable: Dimensions
+//------------------------------------------------------------------------
+
+void PayoffTable::AddPlayer(void)
+{
+  m_doubles.push_back(std::vector<double>(m_numOutcomes, 0.0));
+  m_rationals.push_back(std::vector<Rational>(m_numOutcomes, Rational(0)));
+  m_places.push_back(std::vector<unsigned char>(m_numOutcomes, 0));
+  m_revision++;
+}
+
+void PayoffTable::AddOutcome(void)
+{
+  for (size_t pl = 0; pl < m_doubles.size(); pl++) {
+    m_doubles[pl].push_back(0.0);
+    m_rationals[pl].push_back(Rational(0));
+    m_places[pl].push_back(0);
+  }
+  m_numOutcomes++;
+  m_revision++;
+}
+
+void PayoffTable::RemoveOutcome(int p_outcome)
+{
+  if (p_outcome < 1 || p_outcome > m_numOutcomes)  throw IndexException();
+  for (size_t pl = 0; pl < m_doubles.size(); pl++) {
+    m_doubles[pl].erase(m_doubles[pl].begin() + (p_outcome - 1));
+    m_rationals[pl].erase(m_rationals[pl].begin() + (p_outcome - 1));
+    m_places[pl].erase(m_places[pl].begin() + (p_outcome - 1));
+  }
+  m_numOutcomes--;
+  m_revision++;
+}
+
+//------------------------------------------------------------------------
+//                      PayoffTable: Accessing payoffs
+//------------------------------------------------------------------------
+
+namespace {
+
+/// Returns the smallest number of decimal places needed to write
+/// the rational number exactly, or -1 if it has no finite decimal expansion.
+int DecimalPlaces(const Rational &p_value)
+{
+  Integer den = p_value.denominator();
+  int twos = 0, fives = 0;
+  while (den % 2 == 0)  { den /= 2;  twos++; }
+  while (den % 5 == 0)  { den /= 5;  fives++; }
+  if (den != 1)  return -1;
+  return (twos > fives) ? twos : fives;
+}
+
+/// Parses payoff text in the common simple forms -- an integer, a decimal
+/// without an exponent, or a fraction -- when the numerator and denominator
+/// fit in 31 bits, so that they convert exactly both to Integer and to
+/// double.  The value is returned in lowest terms, with a positive
+/// denominator.  Returns false for any other text, which is left to the
+/// general conversion.
+bool ParseSimpleNumber(const std::string &p_text, long &p_num, long &p_den,
+		       int &p_places)
+{
+  const long LIMIT = 1L << 31;
+  const char *text = p_text.c_str();
+  bool negative = (*text == '-');
+  if (negative)  text++;
+  if (!isdigit(*text) && !(*text == '.' && isdigit(text[1])))  return false;
+
+  p_num = 0;
+  p_den = 1;
+  p_places = 0;
+  for (; isdigit(*text); text++) {
+    p_num = p_num * 10 + (*text - '0');
+    if (p_num >= LIMIT)  return false;
+  }
+  if (*text == '.') {
+    for (text++; isdigit(*text); text++) {
+      p_num = p_num * 10 + (*text - '0');
+      p_den *= 10;
+      if (p_num >= LIMIT || p_den >= LIMIT)  return false;
+      p_places++;
+    }
+    if (p_places == 0)  p_places = 1;
+  }
+  else if (*text == '/') {
+    text++;
+    if (!isdigit(*text))  return false;
+    for (p_den = 0; isdigit(*text); text++) {
+      p_den = p_den * 10 + (*text - '0');
+      if (p_den >= LIMIT)  return false;
+    }
+    if (p_den == 0)  return false;
+  }
+  if (*text != '\0')  return false;
+
+  long a = p_num, b = p_den;
+  while (b != 0) {
+    long t = a % b;
+    a = b;
+    b = t;
+  }
+  if (a > 1) {
+    p_num /= a;
+    p_den /= a;
+  }
+  if (negative)  p_num = -p_num;
+  return true;
+}
+
+}  // end anonymous namespace
+
+std::string PayoffTable::GetText(int p_outcome, int p_player) const
+{
+  const Rational &value = GetRational(p_outcome, p_player);
+  int places = m_places[p_player-1][p_outcome-1];
+  if (places == 0) {
+    return lexical_cast<std::string>(value);
+  }
+
+  Integer scale(1);
+  for (int i = 1; i <= places; i++)  scale *= 10;
+  Integer digits = value.numerator() * scale / value.denominator();
+  std::string text = lexical_cast<std::string>(abs(digits));
+  if ((int) text.length() <= places) {
+    text.insert(0, places + 1 - text.length(), '0');
+  }
+  text.insert(text.length() - places, 1, '.');
+  return (sign(digits) < 0) ? "-" + text : text;
+}
+
+void PayoffTable::SetPayoff(int p_outcome, int p_player,
+			    const std::string &p_value)
+{
+  long num, den;
+  int places;
+  if (ParseSimpleNumber(p_value, num, den, places)) {
+    // This computes the same double as the conversion from Rational
+    long a = (num < 0) ? -num : num;
+    double value = (double) (a / den);
+    if (a % den != 0)  value += (double) (a % den) / (double) den;
+    m_rationals[p_player-1][p_outcome-1] = ((den == 1) ? Rational(num) : 
+					    Rational(num, den));
+    m_doubles[p_player-1][p_outcome-1] = (num < 0) ? -value : value;
+    m_places[p_player-1][p_outcome-1] = places;
+    m_revision++;
+    return;
+  }
+
+  // lexical_cast<Rational>() throws a ValueException if the conversion
+  // of the text fails, in which case the payoff is left unchanged
+  Rational value = lexical_cast<Rational>(p_value);
+  places = 0;
+  std::string::size_type point = p_value.find('.');
+  if (point != std::string::npos) {
+    // Keep as many places as were entered, unless an exponent means
+    // more are needed to write the value exactly
+    std::string::size_type end = p_value.find_first_not_of("0123456789",
+							   point + 1);
+    if (end == std::string::npos)  end = p_value.length();
+    places = end - point - 1;
+    if (end == p_value.length() && places <= 255) {
+      // Without an exponent, the places entered always suffice
+      if (places == 0)  places = 1;
+    }
+    else {
+      int needed = DecimalPlaces(value);
+      if (needed < 0 || needed > 255)  places = 0;
+      else if (needed > places)  places = needed;
+      else if (places == 0)  places = 1;
+      else if (places > 255)  places = needed;
+    }
+  }
+  m_rationals[p_player-1][p_outcome-1] = value;
+  m_doubles[p_player-1][p_outcome-1] = (double) value;
+  m_places[p_player-1][p_outcome-1] = places;
+  m_revision++;
+}
+
+void PayoffTable::CopyOutcome(int p_outcome, const PayoffTable &p_from,
+			      int p_fromOutcome)
+{
+  if (p_from.NumPlayers() != NumPlayers())  throw DimensionException();
+  for (int pl = 0; pl < NumPlayers(); pl++) {
+    m_doubles[pl][p_outcome-1] = p_from.m_doubles[pl][p_fromOutcome-1];
+    m_rationals[pl][p_outcome-1] = p_from.m_rationals[pl][p_fromOutcome-1];
+    m_places[pl][p_outcome-1] = p_from.m_places[pl][p_fromOutcome-1];
+  }
+  m_revision++;
+}
+
+//------------------------------------------------------------------------
+//                       PayoffTable: Binary files
+//------------------------------------------------------------------------
+
+//
+// The payoffs of each player are written as four blocks, each with one
+// entry per outcome: the doubles, the numerators and denominators of the
+// Rationals as 32-bit integers, and the decimal places.  A Rational which
+// does not fit in 32 bits is marked by a zero denominator in its block,
+// and is written as text in a list following the blocks.
+//
+
+void PayoffTable::WriteBinary(BinaryFileWriter &p_file) const
+{
+  const long LIMIT = 1L << 31;
+  p_file.WriteCount(m_doubles.size());
+  p_file.WriteCount(m_numOutcomes);
+  if (m_numOutcomes == 0)  return;
+
+  std::vector<int32_t> nums(m_numOutcomes), dens(m_numOutcomes);
+  for (size_t pl = 0; pl < m_doubles.size(); pl++) {
+    std::vector<int> large;
+    for (int outc = 0; outc < m_numOutcomes; outc++) {
+      const Rational &value = m_rationals[pl][outc];
+      if (value.numerator() < LIMIT && value.numerator() > -LIMIT &&
+	  value.denominator() < LIMIT) {
+	nums[outc] = value.numerator().as_long();
+	dens[outc] = value.denominator().as_long();
+      }
+      else {
+	nums[outc] = dens[outc] = 0;
+	large.push_back(outc);
+      }
+    }
+
+    p_file.WriteArray(&m_doubles[pl][0], m_numOutcomes);
+    p_file.WriteArray(&nums[0], m_numOutcomes);
+    p_file.WriteArray(&dens[0], m_numOutcomes);
+    p_file.WriteArray(&m_places[pl][0], m_numOutcomes);
+    p_file.WriteCount(large.size());
+    for (size_t i = 0; i < large.size(); i++) {
+      p_file.Write<uint32_t>(large[i]);
+      p_file.WriteString(lexical_cast<std::string>(m_rationals[pl][large[i]]));
+    }
+  }
+}
+
+void PayoffTable::ReadBinary(BinaryFileReader &p_file)
+{
+  // Each outcome takes 17 bytes for each player
+  size_t players = p_file.ReadCount(sizeof(uint64_t));
+  size_t outcomes = p_file.ReadCount((players > 0) ? 17 * players : 0);
+  PayoffTable table(players, 0);
+  table.m_numOutcomes = outcomes;
+  table.m_revision = m_revision + 1;
+
+  std::vector<int32_t> nums(outcomes), dens(outcomes);
+  for (size_t pl = 0; pl < players && outcomes > 0; pl++) {
+    table.m_doubles[pl].resize(outcomes);
+    table.m_places[pl].resize(outcomes);
+    p_file.ReadArray(&table.m_doubles[pl][0], outcomes);
+    p_file.ReadArray(&nums[0], outcomes);
+    p_file.ReadArray(&dens[0], outcomes);
+    p_file.ReadArray(&table.m_places[pl][0], outcomes);
+
+    std::vector<Rational> &rationals = table.m_rationals[pl];
+    rationals.reserve(outcomes);
+    size_t marked = 0;
+    for (size_t outc = 0; outc < outcomes; outc++) {
+      if (dens[outc] == 1) {
+	rationals.push_back(Rational((long) nums[outc]));
+      }
+      else if (dens[outc] > 1) {
+	rationals.push_back(Rational((long) nums[outc], (long) dens[outc]));
+      }
+      else if (dens[outc] == 0) {
+	rationals.push_back(Rational(0));
+	marked++;
+      }
+      else {
+	throw InvalidFileException("Invalid payoff in binary game file");
+      }
+    }
+
+    size_t large = p_file.ReadCount(sizeof(uint32_t) + sizeof(uint32_t));
+    if (large != marked) {
+      throw InvalidFileException("Invalid payoff in binary game file");
+    }
+    for (size_t i = 0; i < large; i++) {
+      uint32_t outc = p_file.Read<uint32_t>();
+      if (outc >= outcomes || dens[outc] != 0) {
+	throw InvalidFileException("Invalid payoff in binary game file");
+      }
+      try {
+	rationals[outc] = lexical_cast<Rational>(p_file.ReadString());
+      }
+      catch (ValueException &) {
+	throw InvalidFileException("Invalid payoff in binary game file");
+      }
+      dens[outc] = 1;
+    }
+  }
+
+  m_numOutcomes = table.m_numOutcomes;
+  m_revision = table.m_revision;
+  m_doubles.swap(table.m_doubles);
+  m_rationals.swap(table.m_rationals);
+  m_places.swap(table.m_places);
+}
+
+}  // end namespace Gambit
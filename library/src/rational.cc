@@ -537,107 +537,103 @@ Rational Rational::operator/(const Rational &y) const
 }
 
 
+namespace {
+
+/// Appends the decimal digits starting at p_text to p_value, returning
+/// a pointer past the last digit and setting p_count to the number read.
+/// Digits are accumulated nine at a time in a machine word, so only one
+/// arbitrary-precision operation is done for each group of nine.
+const char *ReadDigits(const char *p_text, Integer &p_value, int &p_count)
+{
+  p_count = 0;
+  while (*p_text >= '0' && *p_text <= '9') {
+    long chunk = 0, scale = 1;
+    for (int i = 0; i < 9 && *p_text >= '0' && *p_text <= '9'; i++) {
+      chunk = chunk * 10 + (*p_text++ - '0');
+      scale *= 10;
+      p_count++;
+    }
+    if (p_value != 0) {
+      p_value *= scale;
+    }
+    p_value += chunk;
+  }
+  return p_text;
+}
+
+/// Multiplies p_value by ten to the power p_exponent
+void ScaleByPowerOfTen(Integer &p_value, long p_exponent)
+{
+  for (; p_exponent >= 9; p_exponent -= 9) {
+    p_value *= 1000000000L;
+  }
+  long scale = 1;
+  for (; p_exponent > 0; p_exponent--) {
+    scale *= 10;
+  }
+  p_value *= scale;
+}
+
+/// Reads an exponent, with an optional minus sign, starting at p_text,
+/// and applies it to the numerator or denominator as appropriate
+const char *ReadExponent(const char *p_text, Integer &p_num, Integer &p_denom)
+{
+  int expsign = 1;
+  long exponent = 0;
+  if (*p_text == '-') {
+    expsign = -1;
+    p_text++;
+  }
+  while (*p_text >= '0' && *p_text <= '9') {
+    exponent = exponent * 10 + (*p_text++ - '0');
+  }
+  ScaleByPowerOfTen((expsign > 0) ? p_num : p_denom, exponent);
+  return p_text;
+}
+
+}  // end anonymous namespace
+
 template<>
 Rational lexical_cast(const std::string &f)
 {
-  char ch = ' ';
-  int sign = 1;
-  unsigned int index = 0, length = f.length();
+  const char *text = f.c_str();
+  int count;
   Integer num = 0, denom = 1;
 
-  while (isspace(ch) && index<=length) {
-    ch = f[index++];
+  while (isspace(*text)) {
+    text++;
   }
 
-  if (ch == '-' && index<=length)  {
-    sign = -1;
-    ch=f[index++];
+  bool negative = (*text == '-');
+  if (negative) {
+    text++;
   }
 
-  while (ch >= '0' && ch <= '9' && index<=length)   {
-    num *= 10;
-    num += (int) (ch - '0');
-    ch=f[index++];
-  }
+  text = ReadDigits(text, num, count);
 
-  if (ch == '/')  {
+  if (*text == '/')  {
     denom = 0;
-    ch=f[index++];
-    while (ch >= '0' && ch <= '9' && index<=length)  {
-      denom *= 10;
-      denom += (int) (ch - '0');
-      ch=f[index++];
-    }
+    text = ReadDigits(text + 1, denom, count);
   }
-  else if (ch == '.')  {
-    denom = 1;
-    ch=f[index++];
-    while (ch >= '0' && ch <= '9' && index<=length)  {
-      denom *= 10;
-      num *= 10;
-      num += (int) (ch - '0');
-      ch=f[index++];
-    }
-    
-    if (ch == 'e' || ch == 'E') {
-      int expsign = 1;
-      Integer exponent = 0;
-      ch = f[index++];
-      if (ch == '-')  {
-	expsign = -1;
-	ch = f[index++];
-      }
-      while (ch >= '0' && ch <= '9' && index <= length) {
-	exponent *= 10;
-	exponent += (int) (ch - '0');
-	ch = f[index++];
-      }
-      if (exponent * expsign > 0) {
-	while (exponent > 0) {
-	  num *= 10;
-	  exponent -= 1;
-	}
-      }
-      else if (exponent * expsign < 0) {
-	while (exponent > 0) {
-	  denom *= 10;
-	  exponent -= 1;
-	}
-      }
+  else if (*text == '.')  {
+    text = ReadDigits(text + 1, num, count);
+    ScaleByPowerOfTen(denom, count);
+    if (*text == 'e' || *text == 'E') {
+      text = ReadExponent(text + 1, num, denom);
     }
   }
-  else if (ch == 'e' || ch == 'E') {
-    int expsign = 1;
-    Integer exponent = 0;
-    ch = f[index++];
-    if (ch == '-')  {
-      expsign = -1;
-      ch = f[index++];
-    }
-    while (ch >= '0' && ch <= '9' && index <= length) {
-      exponent *= 10;
-      exponent += (int) (ch - '0');
-      ch = f[index++];
-    }
-    if (exponent * expsign > 0) {
-      while (exponent > 0) {
-	num *= 10;
-	exponent -= 1;
-      }
-    }
-    else if (exponent * expsign < 0) {
-      while (exponent > 0) {
-	denom *= 10;
-	exponent -= 1;
-      }
-    }
+  else if (*text == 'e' || *text == 'E') {
+    text = ReadExponent(text + 1, num, denom);
   }
 
-  if (ch != '\0') {
+  if (*text != '\0') {
     throw ValueException();
   }
 
-  return Rational(num * sign, denom);
+  if (negative) {
+    num.negate();
+  }
+  return Rational(num, denom);
 }
 
 }  // end namespace Gambit
@@ -20,6 +20,8 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <cmath>
+
 #include "gambit/gambit.h"
 #include "gambit/nash/simpdiv.h"
 
@@ -35,9 +37,9 @@ inline GameStrategy GetStrategy(const Game &game, int pl, int st)
   return game->Players()[pl]->Strategies()[st];
 }
 
-Rational 
-NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
-				   const Rational &d) const
+template <class T> T
+NashSimpdivStrategySolver<T>::Simplex(MixedStrategyProfile<T> &y,
+				      const T &d) const
 {
   Game game = y.GetGame();
   State state;
@@ -46,24 +48,24 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
   Array<int> ylabel(2);
   RectArray<int> labels(y.MixedProfileLength(), 2), pi(y.MixedProfileLength(), 2);
   PVector<int> U(nstrats), TT(nstrats);
-  PVector<Rational> ab(nstrats), besty(nstrats), v(nstrats);
+  PVector<T> ab(nstrats), besty(nstrats), v(nstrats);
   for (int i = 1; i <= v.Length(); i++) {
     v[i] = y[i];
   }
-  besty = static_cast<Vector<Rational> &>(y);
+  besty = static_cast<Vector<T> &>(y);
   int i = 0;
   int j, k, h, jj, hh,ii, kk,tot;
-  Rational maxz;
+  T maxz;
 
 // Label step0 not currently used, hence commented
 // step0:
   TT = 0;
   U = 0;
-  ab = Rational(0);
+  ab = (T) 0;
   for (j = 1; j <= game->NumPlayers(); j++)  {
     GamePlayer player = game->Players()[j];
     for (h = 1; h <= nstrats[j]; h++)  {
-      if (v(j,h) == Rational(0)) {
+      if (v(j,h) < d / (T) 2) {
 	U(j,h) = 1;
       }
       y[player->Strategies()[h]] = v(j,h);
@@ -156,9 +158,7 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
   getY(state, y, v, U, TT, ab, pi, ii);
   
   /* case3a */
-  if (i==1 && 
-      (y[GetStrategy(game, j, k)]<=Rational(0) || 
-       (v(j,k)-y[GetStrategy(game, j, k)]) >= Rational(m_leashLength)*state.d)) {
+  if (i==1 && OutOfBounds(y[GetStrategy(game, j, k)], v(j,k), state.d)) {
     for (hh = 1, tot = 0; hh <= nstrats[j]; hh++) {
       if (TT(j,hh)==1 || U(j,hh)==1)  {
 	tot++;
@@ -177,19 +177,17 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
   }
   /* case3b */
   else if (i>=2 && i<=state.t &&
-	   (y[GetStrategy(game, j, k)] <= Rational(0) || 
-	    (v(j,k)-y[GetStrategy(game, j, k)]) >= Rational(m_leashLength)*state.d)) {
+	   OutOfBounds(y[GetStrategy(game, j, k)], v(j,k), state.d)) {
     goto step4;
   }
   /* case3c */
-  else if (i==state.t+1 && ab(j,kk) == Rational(0)) {
-    if (y[GetStrategy(game, j, h)] <= Rational(0) || 
-	(v(j,h)-y[GetStrategy(game, j, h)]) >= Rational(m_leashLength)*state.d) {
+  else if (i==state.t+1 && ab(j,kk) == (T) 0) {
+    if (OutOfBounds(y[GetStrategy(game, j, h)], v(j,h), state.d)) {
       goto step4;
     }
     else {
       k=0;
-      while (ab(j,kk) == Rational(0) && k==0) {
+      while (ab(j,kk) == (T) 0 && k==0) {
 	if(kk==h)k=1;
 	kk++;
 	if (kk > nstrats[j]) {
@@ -231,8 +229,7 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
   j = pi(i-1,1);
   h = pi(i-1,2);
   TT(j,h) = 0;
-  if (y[GetStrategy(game, j, h)] <= Rational(0) || 
-      (v(j,h)-y[GetStrategy(game, j, h)]) >= Rational(m_leashLength)*state.d) {
+  if (OutOfBounds(y[GetStrategy(game, j, h)], v(j,h), state.d)) {
     U(j,h) = 1;
   }
   labels.RotateUp(i,state.t+1);
@@ -263,7 +260,7 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
     if (k == h) {
       kk = 0;
     }
-    ab(j,k) -= Rational(1);
+    ab(j,k) -= (T) 1;
     k++;
     if (k > nstrats[j]) {
       k = 1;
@@ -281,12 +278,13 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
   return maxz;
 }
 
-void NashSimpdivStrategySolver::update(State &state,
-				       RectArray<int> &pi,
-				       RectArray<int> &labels,
-				       PVector<Rational> &ab,
-				       const PVector<int> &U,
-				       int j, int i) const
+template <class T>
+void NashSimpdivStrategySolver<T>::update(State &state,
+					  RectArray<int> &pi,
+					  RectArray<int> &labels,
+					  PVector<T> &ab,
+					  const PVector<int> &U,
+					  int j, int i) const
 {
   int jj, hh, k,f;
   
@@ -304,7 +302,7 @@ void NashSimpdivStrategySolver::update(State &state,
       k=get_c(jj,hh,ab.Lengths()[jj],U);
       while(f) {
 	if(k==hh)f=0;
-	ab(j,k) += Rational(1);
+	ab(j,k) += (T) 1;
 	k++;
 	if(k>ab.Lengths()[jj])k=1;
       }
@@ -320,7 +318,7 @@ void NashSimpdivStrategySolver::update(State &state,
       k=get_c(jj,hh,ab.Lengths()[jj],U);
       while(f) {
 	if(k==hh)f=0;
-	ab(j,k) -= Rational(1);
+	ab(j,k) -= (T) 1;
 	k++;
 	if(k>ab.Lengths()[jj])k=1;
       }
@@ -329,16 +327,17 @@ void NashSimpdivStrategySolver::update(State &state,
   }
 }
 
-void NashSimpdivStrategySolver::getY(State &state,
-				     MixedStrategyProfile<Rational> &x,
-				     PVector<Rational> &v, 
-				     const PVector<int> &U,
-				     const PVector<int> &TT,
-				     const PVector<Rational> &ab,
-				     const RectArray<int> &pi,
-				     int k) const
+template <class T>
+void NashSimpdivStrategySolver<T>::getY(State &state,
+					MixedStrategyProfile<T> &x,
+					PVector<T> &v, 
+					const PVector<int> &U,
+					const PVector<int> &TT,
+					const PVector<T> &ab,
+					const RectArray<int> &pi,
+					int k) const
 {
-  static_cast<Vector<Rational> & >(x) = v;
+  static_cast<Vector<T> & >(x) = v;
   for (size_t j = 1; j <= x.GetGame()->Players().size(); j++) {
     GamePlayer player = x.GetGame()->Players()[j];
     for (size_t h = 1; h <= player->Strategies().size(); h++) {
@@ -354,11 +353,12 @@ void NashSimpdivStrategySolver::getY(State &state,
   }
 }
 
-void NashSimpdivStrategySolver::getnexty(State &state,
-					 MixedStrategyProfile<Rational> &x,
-					 const RectArray<int> &pi, 
-					 const PVector<int> &U,
-					 int i) const
+template <class T>
+void NashSimpdivStrategySolver<T>::getnexty(State &state,
+					    MixedStrategyProfile<T> &x,
+					    const RectArray<int> &pi, 
+					    const PVector<int> &U,
+					    int i) const
 {
   int j = pi(i,1);
   GamePlayer player = x.GetGame()->Players()[j];
@@ -368,7 +368,9 @@ void NashSimpdivStrategySolver::getnexty(State &state,
   x[player->Strategies()[hh]] -= state.d;
 }
 
-int NashSimpdivStrategySolver::get_b(int j, int h, int nstrats, const PVector<int> &U) const
+template <class T>
+int NashSimpdivStrategySolver<T>::get_b(int j, int h, int nstrats,
+					const PVector<int> &U) const
 {
   int hh = (h > 1) ? h-1 : nstrats;
   while (U(j,hh)) {
@@ -380,26 +382,42 @@ int NashSimpdivStrategySolver::get_b(int j, int h, int nstrats, const PVector<in
   return hh;
 }
 
-int NashSimpdivStrategySolver::get_c(int j, int h, int nstrats,
-				     const PVector<int> &U) const
+template <class T>
+int NashSimpdivStrategySolver<T>::get_c(int j, int h, int nstrats,
+					const PVector<int> &U) const
 {
   int hh = get_b(j, h, nstrats, U) + 1;
   return (hh > nstrats) ? 1 : hh;
 }
 
-Rational 
-NashSimpdivStrategySolver::State::getlabel(MixedStrategyProfile<Rational> &yy,
-					   Array<int> &ylabel,
-					   PVector<Rational> &besty)
+//
+// Returns true if a coordinate y of a point of the grid of size d has
+// reached the boundary of the simplex, or the end of the leash from
+// the coordinate v of the restart point.  Since y and v lie on the
+// grid, the comparisons can leave half a step to spare, which keeps
+// them correct in floating point.
+//
+template <class T>
+bool NashSimpdivStrategySolver<T>::OutOfBounds(const T &y, const T &v,
+					       const T &d) const
+{
+  return (y < d / (T) 2 ||
+	  v - y > ((T) m_leashLength - (T) 1 / (T) 2) * d);
+}
+
+template <class T> T
+NashSimpdivStrategySolver<T>::State::getlabel(MixedStrategyProfile<T> &yy,
+					      Array<int> &ylabel,
+					      PVector<T> &besty)
 {
-  Rational maxz = -1000000;
+  T maxz = -1000000;
   ylabel[1] = 1;
   ylabel[2] = 1;
   
   for (int i = 1; i <= yy.GetGame()->NumPlayers(); i++) {
     GamePlayer player = yy.GetGame()->Players()[i];
-    Rational payoff = 0;
-    Rational maxval = -1000000;
+    T payoff = 0;
+    T maxval = -1000000;
     int jj = 0;
     for (size_t j = 1; j <= player->Strategies().size(); j++) {
       pay = yy.GetPayoff(player->Strategies()[j]);
@@ -431,6 +449,11 @@ NashSimpdivStrategySolver::State::getlabel(MixedStrategyProfile<Rational> &yy,
 //           NashSimpdivStrategySolver: Main solution algorithm
 //-------------------------------------------------------------------------
 
+namespace {
+
+/// Profiles at which no player can gain more than this are accepted
+const double TOL = 1.0e-10;
+
 inline Integer find_lcd(const Vector<Rational> &vec)
 {
   Integer lcd(1);
@@ -440,9 +463,79 @@ inline Integer find_lcd(const Vector<Rational> &vec)
   return lcd;
 }
 
+template <class T> MixedStrategyProfile<T> 
+ToNumber(const MixedStrategyProfile<Rational> &p_profile)
+{
+  MixedStrategyProfile<T> profile(p_profile.GetGame()->NewMixedStrategyProfile(static_cast<T>(0)));
+  for (int i = 1; i <= profile.MixedProfileLength(); i++) {
+    profile[i] = static_cast<T>(p_profile[i]);
+  }
+  return profile;
+}
+
+}  // end anonymous namespace
+
+template <class T> void
+NashSimpdivStrategySolver<T>::Subdivide(MixedStrategyProfile<T> &y,
+					Rational &d) const
+{
+  while (true) {
+    d /= m_gridResize;
+    T maxz = Simplex(y, static_cast<T>(d));
+    
+    if (m_verbose) {
+      this->m_onEquilibrium->Render(y, lexical_cast<std::string>(d));
+    }
+    if (maxz < static_cast<T>(TOL)) break;
+  }
+}
+
+///
+/// Checks the equilibrium found on the grid of size d in exact arithmetic,
+/// refining it further in exact arithmetic if need be.
+/// Nothing needs to be done when computing in exact arithmetic.
+///
+template<> void
+NashSimpdivStrategySolver<Rational>::Certify(MixedStrategyProfile<Rational> &,
+					     Rational &) const
+{ }
+
+template<> void
+NashSimpdivStrategySolver<double>::Certify(MixedStrategyProfile<double> &y,
+					   Rational &d) const
+{
+  // Move to the nearest point of the grid.  Any rounding left over in
+  // a player's probabilities goes to that player's most likely strategy.
+  Game game = y.GetGame();
+  MixedStrategyProfile<Rational> x(game->NewMixedStrategyProfile(Rational(0)));
+  for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+    GamePlayer player = game->Players()[pl];
+    Rational total(0);
+    GameStrategy best = player->Strategies()[1];
+    for (size_t st = 1; st <= player->Strategies().size(); st++) {
+      GameStrategy strategy = player->Strategies()[st];
+      x[strategy] = Rational(lround(y[strategy] / static_cast<double>(d))) * d;
+      total += x[strategy];
+      if (y[strategy] > y[best]) {
+	best = strategy;
+      }
+    }
+    x[best] += Rational(1) - total;
+  }
+
+  NashSimpdivStrategySolver<Rational> exact(m_gridResize, m_leashLength);
+  NashSimpdivStrategySolver<Rational>::State state;
+  Array<int> label(2);
+  PVector<Rational> besty(game->NumStrategies());
+  if (state.getlabel(x, label, besty) >= Rational(TOL) &&
+      exact.Simplex(x, d) >= Rational(TOL)) {
+    exact.Subdivide(x, d);
+  }
+  y = ToNumber<double>(x);
+}
 
-List<MixedStrategyProfile<Rational> >
-NashSimpdivStrategySolver::Solve(const MixedStrategyProfile<Rational> &p_start) const
+template <class T> List<MixedStrategyProfile<T> >
+NashSimpdivStrategySolver<T>::Solve(const MixedStrategyProfile<Rational> &p_start) const
 {
   if (!p_start.GetGame()->IsPerfectRecall()) {
     throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
@@ -450,24 +543,16 @@ NashSimpdivStrategySolver::Solve(const MixedStrategyProfile<Rational> &p_start)
   Integer k = find_lcd((const Vector<Rational> &) p_start);
   Rational d = Rational(1, k);
     
-  MixedStrategyProfile<Rational> y(p_start);
+  MixedStrategyProfile<T> y(ToNumber<T>(p_start));
   if (m_verbose) {
     this->m_onEquilibrium->Render(y, "start");
   }
 
-  while (true) {
-    const double TOL = 1.0e-10;
-    d /= m_gridResize;
-    Rational maxz = Simplex(y, d);
-    
-    if (m_verbose) {
-      this->m_onEquilibrium->Render(y, lexical_cast<std::string>(d));
-    }
-    if (maxz < Rational(TOL)) break;
-  }
+  Subdivide(y, d);
+  Certify(y, d);
     
   this->m_onEquilibrium->Render(y);
-  List<MixedStrategyProfile<Rational> > sol;
+  List<MixedStrategyProfile<T> > sol;
   sol.push_back(y);
   return sol;
 }
@@ -484,8 +569,8 @@ NashSimpdivStrategySolver::Solve(const MixedStrategyProfile<Rational> &p_start)
 /// to a long initial search before reaching a candidate neighborhood
 /// for an equilibrium.
 ///
-List<MixedStrategyProfile<Rational> >
-NashSimpdivStrategySolver::Solve(const Game &p_game) const
+template <class T> List<MixedStrategyProfile<T> >
+NashSimpdivStrategySolver<T>::Solve(const Game &p_game) const
 {
   MixedStrategyProfile<Rational> start = p_game->NewMixedStrategyProfile(Rational(0));
   static_cast<Vector<Rational> &>(start) = Rational(0);
@@ -494,8 +579,9 @@ NashSimpdivStrategySolver::Solve(const Game &p_game) const
   }
   return Solve(start);
 }
-  
+
+template class NashSimpdivStrategySolver<double>;
+template class NashSimpdivStrategySolver<Rational>;
 
 }  // end namespace Gambit::Nash
 }  // end namespace Gambit
-
@@ -119,6 +119,19 @@ cdef class GameStrategies(Collection):
         s.strategy = self.game.deref().GetStrategy(st+1)
         return s
 
+cdef class DeferredCanonicalization(object):
+    "Context manager deferring the canonicalization of a game tree."
+    cdef c_Game game
+    cdef bool previous
+
+    def __enter__(self):
+        self.previous = SetCanonicalization(self.game, False)
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        SetCanonicalization(self.game, self.previous)
+        return False
+
 cdef class Game(object):
     cdef c_Game game
 
@@ -201,6 +214,10 @@ cdef class Game(object):
         def __get__(self):
             return True if self.game.deref().IsTree() != 0 else False
 
+    property is_frozen:
+        def __get__(self):
+            return self.game.deref().IsFrozen()
+
     property title:
         def __get__(self):
             return self.game.deref().GetTitle().decode('ascii')
@@ -369,6 +386,29 @@ cdef class Game(object):
     def support_profile(self):
         return StrategySupportProfile(list(self.strategies), self)
 
+    def deferred_canonicalization(self):
+        """Returns a context manager for building or editing a game tree.
+        Nodes and information sets are renumbered once, on leaving the
+        context, rather than after every change; within it, their numbers
+        are not meaningful."""
+        cdef DeferredCanonicalization d
+        if not self.is_tree:
+            raise UndefinedOperationError("Operation only defined for "\
+                                           "games with a tree representation")
+        d = DeferredCanonicalization()
+        d.game = self.game
+        return d
+
+    def freeze(self):
+        """Returns a frozen copy of the game.  A frozen game cannot be
+        changed, but reading it changes nothing, so it can be shared by
+        solvers running in several threads at once.  Freezing a frozen
+        game returns the same game."""
+        cdef Game g
+        g = Game()
+        g.game = self.game.deref().Freeze()
+        return g
+
     def num_nodes(self):
         if self.is_tree:
             return self.game.deref().NumNodes()
@@ -53,10 +53,6 @@ cdef extern from "gambit/rational.h":
 cdef rat_to_py(c_Rational r):
     return Rational(rat_str(r).decode('ascii'))
 
-cdef extern from "gambit/number.h":
-    cdef cppclass c_Number "Number":
-        string as_string "operator const string &"()
-     
 cdef extern from "gambit/array.h":
     cdef cppclass Array[T]: 
         T getitem "operator[]"(int) except +
@@ -148,7 +144,7 @@ cdef extern from "gambit/game.h":
         int NumMembers()
         c_GameNode GetMember(int) except +IndexError
         
-        void Reveal(c_GamePlayer)
+        void Reveal(c_GamePlayer) except +ValueError
         bint IsChanceInfoset()
         bint Precedes(c_GameNode)
 
@@ -165,7 +161,7 @@ cdef extern from "gambit/game.h":
 
         int NumInfosets()
         c_GameInfoset GetInfoset(int) except +IndexError
-        c_GameStrategy NewStrategy()
+        c_GameStrategy NewStrategy() except +ValueError
 
     cdef cppclass c_GameOutcomeRep "GameOutcomeRep":
         c_Game GetGame()
@@ -174,7 +170,7 @@ cdef extern from "gambit/game.h":
         string GetLabel()
         void SetLabel(string)
      
-        c_Number GetPayoffNumber "GetPayoff<Number>"(int) except +IndexError
+        string GetPayoffText "GetPayoff<std::string>"(int) except +IndexError
         void SetPayoff(int, string) except +IndexError
 
     cdef cppclass c_GameNodeRep "GameNodeRep":
@@ -186,13 +182,13 @@ cdef extern from "gambit/game.h":
 
         c_GameInfoset GetInfoset()
         void SetInfoset(c_GameInfoset) except +ValueError
-        c_GameInfoset LeaveInfoset()
+        c_GameInfoset LeaveInfoset() except +ValueError
         c_GamePlayer GetPlayer()
         c_GameNode GetParent()
         int NumChildren()
         c_GameNode GetChild(int) except +IndexError
         c_GameOutcome GetOutcome()
-        void SetOutcome(c_GameOutcome) 
+        void SetOutcome(c_GameOutcome) except +ValueError
         c_GameNode GetPriorSibling()
         c_GameNode GetNextSibling() 
         bint IsTerminal()
@@ -204,13 +200,15 @@ cdef extern from "gambit/game.h":
         c_GameInfoset AppendMove(c_GameInfoset) except +ValueError
         c_GameInfoset InsertMove(c_GamePlayer, int) except +ValueError
         c_GameInfoset InsertMove(c_GameInfoset) except +ValueError
-        void DeleteParent()
-        void DeleteTree()
+        void DeleteParent() except +ValueError
+        void DeleteTree() except +ValueError
         void CopyTree(c_GameNode) except +ValueError
         void MoveTree(c_GameNode) except +ValueError
 
     cdef cppclass c_GameRep "GameRep":
         int IsTree()
+        c_Game Freeze() except +ValueError
+        bint IsFrozen()
         
         string GetTitle()
         void SetTitle(string)
@@ -221,12 +219,12 @@ cdef extern from "gambit/game.h":
         int NumPlayers()
         c_GamePlayer GetPlayer(int) except +IndexError
         c_GamePlayer GetChance()
-        c_GamePlayer NewPlayer()
+        c_GamePlayer NewPlayer() except +ValueError
 
         int NumOutcomes()
         c_GameOutcome GetOutcome(int) except +IndexError
-        c_GameOutcome NewOutcome()
-        void DeleteOutcome(c_GameOutcome)
+        c_GameOutcome NewOutcome() except +ValueError
+        void DeleteOutcome(c_GameOutcome) except +ValueError
         
         int NumNodes()
         c_GameNode GetRoot()
@@ -254,7 +252,7 @@ cdef extern from "gambit/game.h":
         void SetStrategy(c_GameStrategy)
 
         c_GameOutcome GetOutcome()
-        void SetOutcome(c_GameOutcome)
+        void SetOutcome(c_GameOutcome) except +ValueError
 
         c_Rational GetPayoff(int)
 
@@ -371,6 +369,7 @@ cdef extern from "util.h":
     c_Game ParseGame(char *) except +IOError
     string WriteGame(c_Game, string) except +IOError
     string WriteGame(c_StrategySupportProfile) except +IOError
+    bool SetCanonicalization(c_Game, bool)
 
     c_Rational to_rational(char *)
     
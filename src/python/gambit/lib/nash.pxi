@@ -316,7 +316,7 @@ cdef class LPStrategySolverRational(object):
 
 
 cdef extern from "gambit/nash/simpdiv.h":
-    cdef cppclass c_NashSimpdivStrategySolver "NashSimpdivStrategySolver":
+    cdef cppclass c_NashSimpdivStrategySolver "NashSimpdivStrategySolver<Rational>":
         c_NashSimpdivStrategySolver()
         c_List[c_MixedStrategyProfileRational] Solve(c_Game) except +RuntimeError
         c_List[c_MixedStrategyProfileRational] Solve(c_MixedStrategyProfileRational) except +RuntimeError
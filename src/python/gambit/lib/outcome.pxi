@@ -74,12 +74,12 @@ cdef class Outcome:
     def __getitem__(self, player):
         cdef bytes py_string
         if isinstance(player, Player):
-            py_string = self.outcome.deref().GetPayoffNumber(player.number+1).as_string().c_str()
+            py_string = self.outcome.deref().GetPayoffText(player.number+1).c_str()
         elif isinstance(player, str):
             number = self.game.players[player].number
-            py_string = self.outcome.deref().GetPayoffNumber(number+1).as_string().c_str()
+            py_string = self.outcome.deref().GetPayoffText(number+1).c_str()
         elif isinstance(player, int):
-            py_string = self.outcome.deref().GetPayoffNumber(player+1).as_string().c_str()
+            py_string = self.outcome.deref().GetPayoffText(player+1).c_str()
         if "." in py_string.decode('ascii'):
             return decimal.Decimal(py_string.decode('ascii'))
         else:
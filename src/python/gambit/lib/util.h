@@ -30,6 +30,7 @@
 #include <fstream>
 #include <sstream>
 #include "gambit/gambit.h"
+#include "gambit/gametree.h"
 #include "gambit/nash.h"
 
 using namespace std;
@@ -71,6 +72,16 @@ std::string WriteGame(const StrategySupportProfile &p_support)
   return f.str();
 }
 
+// Turn automatic canonicalization of a game tree on or off, returning
+// the previous setting
+bool SetCanonicalization(const Game &p_game, bool p_doCanon)
+{
+  GameTreeRep &tree = dynamic_cast<GameTreeRep &>(*p_game);
+  bool previous = tree.GetCanonicalization();
+  tree.SetCanonicalization(p_doCanon);
+  return previous;
+}
+
 // Create a copy on the heap (via new) of the element at index p_index of 
 // container p_container.
 template <template<class> class C, class T, class X> 
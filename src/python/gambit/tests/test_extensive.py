@@ -28,3 +28,17 @@ class TestGambitExtensiveGame(object):
 		assert str(self.game.players[0]) == "<Player [0] 'Alice' in game 'A simple poker example'>"
 		assert str(p.label) == "Alice"
 		
+
+	def test_deferred_canonicalization(self):
+		"Test building a tree with canonicalization deferred"
+		p = self.game.players.add("Alice")
+		q = self.game.players.add("Bob")
+		with self.game.deferred_canonicalization():
+			self.game.root.append_move(p, 2)
+			self.game.root.children[1].append_move(q, 2)
+			iset = self.game.root.children[0].append_move(q, 2)
+			self.game.root.children[1].children[0].append_move(iset)
+		assert len(self.game.players[1].infosets) == 2
+		assert self.game.players[1].infosets[0] == iset
+		assert len(iset.members) == 2
+		assert iset.members[0] == self.game.root.children[0]
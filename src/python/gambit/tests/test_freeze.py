@@ -0,0 +1,53 @@
+import glob
+import threading
+import gambit
+from nose.tools import assert_raises
+
+class TestGambitFrozenGame(object):
+	def setUp(self):
+		self.game = gambit.Game.read_game("test_games/basic_extensive_game.efg")
+		self.frozen = self.game.freeze()
+
+	def tearDown(self):
+		del self.game
+		del self.frozen
+
+	def test_freeze_copies(self):
+		"Test that freezing makes a frozen copy of the game"
+		assert self.frozen.is_frozen
+		assert not self.game.is_frozen
+		assert self.frozen != self.game
+		assert self.frozen.write() == self.game.write()
+
+	def test_freeze_frozen(self):
+		"Test that freezing a frozen game returns the same game"
+		assert self.frozen.freeze() == self.frozen
+
+	def test_frozen_new_player(self):
+		"Test that players cannot be added to a frozen game"
+		assert_raises(ValueError, self.frozen.players.add, "Carol")
+
+	def test_frozen_new_outcome(self):
+		"Test that outcomes cannot be added to a frozen game"
+		assert_raises(ValueError, self.frozen.outcomes.add, "Draw")
+
+	def test_frozen_threads(self):
+		"Test reading frozen games from several threads at once"
+		for fn in (glob.glob("../../../../contrib/games/*.nfg") +
+			   glob.glob("../../../../contrib/games/e0*.efg")):
+			frozen = gambit.Game.read_game(fn).freeze()
+			expected = self._payoffs(frozen)
+			results = [ None ] * 8
+			def worker(i):
+				results[i] = self._payoffs(frozen)
+			threads = [ threading.Thread(target=worker, args=(i,))
+				    for i in range(len(results)) ]
+			for t in threads:
+				t.start()
+			for t in threads:
+				t.join()
+			assert results == [ expected ] * len(results)
+
+	def _payoffs(self, game):
+		profile = game.mixed_strategy_profile(rational=True)
+		return [ profile.payoff(player) for player in game.players ]
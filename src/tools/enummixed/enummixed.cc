@@ -27,6 +27,8 @@
 #include <fstream>
 #include <cerrno>
 #include <iomanip>
+#include <algorithm>
+#include <thread>
 
 #include "gambit/gambit.h"
 #include "gambit/nash/enummixed.h"
@@ -67,6 +69,8 @@ void PrintHelp(char *progname)
   std::cerr << "                   display results with DECIMALS digits\n";
   std::cerr << "  -D               don't eliminate dominated strategies first\n";
   std::cerr << "  -L               use lrslib for enumeration (experimental!)\n";
+  std::cerr << "  -t THREADS       enumerate vertices in THREADS threads\n";
+  std::cerr << "                   (default is 1; 0 uses one per processor)\n";
   std::cerr << "  -c               output connectedness information\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
@@ -79,15 +83,16 @@ int main(int argc, char *argv[])
   int c;
   bool useFloat = false, uselrs = false, quiet = false, eliminate = true;
   bool showConnect = false;
-  int numDecimals = 6;
+  int numDecimals = 6, numThreads = 1;
 
   int long_opt_index = 0;
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
     { "version", 0, NULL, 'v'  },
+    { "threads", 1, NULL, 't'  },
     { 0,    0,    0,    0   }
   };
-  while ((c = getopt_long(argc, argv, "d:DvhqcSL", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:DvhqcSLt:", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -101,6 +106,12 @@ int main(int argc, char *argv[])
     case 'L':
       uselrs = true;
       break;
+    case 't':
+      numThreads = atoi(optarg);
+      if (numThreads <= 0) {
+	numThreads = std::max(1U, std::thread::hardware_concurrency());
+      }
+      break;
     case 'h':
       PrintHelp(argv[0]);
       break;
@@ -154,7 +165,7 @@ int main(int argc, char *argv[])
       shared_ptr<StrategyProfileRenderer<double> > renderer;
       renderer = new MixedStrategyCSVRenderer<double>(std::cout,
 						      numDecimals);
-      EnumMixedStrategySolver<double> solver(renderer);
+      EnumMixedStrategySolver<double> solver(renderer, numThreads);
       shared_ptr<EnumMixedStrategySolution<double> > solution =
 	solver.SolveDetailed(game);
       if (showConnect) {
@@ -166,7 +177,7 @@ int main(int argc, char *argv[])
     else {
       shared_ptr<StrategyProfileRenderer<Rational> > renderer;
       renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
-      EnumMixedStrategySolver<Rational> solver(renderer);
+      EnumMixedStrategySolver<Rational> solver(renderer, numThreads);
       shared_ptr<EnumMixedStrategySolution<Rational> > solution =
 	solver.SolveDetailed(game);
       if (showConnect) {
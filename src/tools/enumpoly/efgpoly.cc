@@ -27,7 +27,6 @@
 using namespace Gambit;
 
 #include "efgensup.h"
-#include "sfg.h"
 #include "gpoly.h"
 #include "gpolylst.h"
 #include "rectangl.h"
@@ -43,7 +42,7 @@ extern bool g_verbose;
 class ProblemData {
 public:
   const BehaviorSupportProfile &support;
-  Sfg SF;
+  SequenceForm SF;
   gSpace *Space;
   term_order *Lex;
   int nVars;
@@ -56,7 +55,10 @@ public:
 ProblemData::ProblemData(const BehaviorSupportProfile &p_support)
   : support(p_support), SF(p_support)
 {
-  nVars = SF.TotalNumSequences() - SF.NumPlayerInfosets() - SF.NumPlayers();
+  nVars = 0;
+  for (int pl = 1; pl <= SF.NumPlayers(); pl++) {
+    nVars += SF.NumSequences(pl) - SF.NumInfosets(pl) - 1;
+  }
   Space = new gSpace(nVars);
   Lex = new term_order(Space, lex);
 
@@ -66,8 +68,8 @@ ProblemData::ProblemData(const BehaviorSupportProfile &p_support)
     var[pl] = Array<int>(SF.NumSequences(pl));
     var[pl][1] = 0;
     for (int seq = 2; seq <= SF.NumSequences(pl); seq++) {
-      int act = SF.ActionNumber(pl, seq);
-      GameInfoset infoset = SF.GetInfoset(pl, seq); 
+      int act = SF.GetSequenceAction(pl, seq);
+      GameInfoset infoset = SF.GetInfoset(pl, SF.GetSequenceInfoset(pl, seq));
       if (act < p_support.NumActions(infoset)) {
 	var[pl][seq] = ++tnv;
       }
@@ -100,12 +102,10 @@ gPoly<double> ProbOfSequence(const ProblemData &p_data,
 {
   gPoly<double> equation(p_data.Space, p_data.Lex);
   Vector<int> exps(p_data.nVars);
-  int j = 0;
   
-  int isetrow = p_data.SF.InfosetRowNumber(p,seq);
-  int act  = p_data.SF.ActionNumber(p,seq);
+  int isetrow = p_data.SF.GetSequenceInfoset(p,seq);
+  int act  = p_data.SF.GetSequenceAction(p,seq);
   int varno = p_data.var[p][seq];
-  GameInfoset infoset = p_data.SF.GetInfoset(p, seq);
 
   if(seq==1) {
     exps=0;
@@ -114,7 +114,7 @@ gPoly<double> ProbOfSequence(const ProblemData &p_data,
     gPoly<double> new_term(p_data.Space,const_term,p_data.Lex);
     equation+=new_term;
   }
-  else if(act<p_data.support.NumActions(infoset)) {
+  else if(act<p_data.support.NumActions(p_data.SF.GetInfoset(p, isetrow))) {
     exps=0;
     exps[varno]=1;
     exp_vect const_exp(p_data.Space,exps);
@@ -123,13 +123,13 @@ gPoly<double> ProbOfSequence(const ProblemData &p_data,
     equation+=new_term;
   }
   else {
-    for(j=1;j<seq;j++) {
-      if (p_data.SF.Constraints(p)(isetrow, j) == Rational(-1)) {
-	equation -= ProbOfSequence(p_data, p, j);
-      }
-      else if (p_data.SF.Constraints(p)(isetrow,j) == Rational(1)) {
-	equation += ProbOfSequence(p_data, p, j);
-      }
+    // The last action is played with the probability of reaching the
+    // information set, less that of the other actions
+    equation += ProbOfSequence(p_data, p, 
+			       p_data.SF.GetParentSequence(p, isetrow));
+    for (int a = 1; a < act; a++) {
+      equation -= ProbOfSequence(p_data, p, 
+				 p_data.SF.GetSequence(p, isetrow, a));
     }
   }
   return equation;
@@ -137,17 +137,14 @@ gPoly<double> ProbOfSequence(const ProblemData &p_data,
 
 gPoly<double> GetPayoff(const ProblemData &p_data, int pl)
 {
-  gIndexOdometer index(p_data.SF.NumSequences());
-  Rational pay;
-
   gPoly<double> equation(p_data.Space, p_data.Lex);
-  while (index.Turn()) {
-    pay=p_data.SF.Payoff(index.CurrentIndices(),pl);
+  for (int e = 1; e <= p_data.SF.NumEntries(); e++) {
+    const Rational &pay = p_data.SF.GetEntryPayoff(e, pl);
     if( pay != Rational(0)) {
       gPoly<double> term(p_data.Space,(double) pay, p_data.Lex);
       int k;
       for(k=1;k<=p_data.support.GetGame()->NumPlayers();k++) 
-	term*=ProbOfSequence(p_data, k,(index.CurrentIndices())[k]);
+	term*=ProbOfSequence(p_data, k, p_data.SF.GetEntrySequence(e, k));
       equation+=term;
     }
   }
@@ -179,8 +176,8 @@ LastActionProbPositiveInequalities(const ProblemData &p_data)
 
   for (int i = 1; i <= p_data.SF.NumPlayers(); i++) 
     for (int j = 2; j <= p_data.SF.NumSequences(i); j++) {
-      int act_num = p_data.SF.ActionNumber(i,j);
-      GameInfoset infoset = p_data.SF.GetInfoset(i, j);
+      int act_num = p_data.SF.GetSequenceAction(i,j);
+      GameInfoset infoset = p_data.SF.GetInfoset(i, p_data.SF.GetSequenceInfoset(i,j));
       if ( act_num == p_data.support.NumActions(infoset) && act_num > 1 ) 
 	equations += ProbOfSequence(p_data, i,j);
     }
@@ -207,39 +204,46 @@ double
 NumProbOfSequence(const ProblemData &p_data, int p,
 		  int seq, const Vector<double> &x)
 {
-  int isetrow = p_data.SF.InfosetRowNumber(p,seq);
-  int act  = p_data.SF.ActionNumber(p,seq);
+  int isetrow = p_data.SF.GetSequenceInfoset(p,seq);
+  int act  = p_data.SF.GetSequenceAction(p,seq);
   int varno = p_data.var[p][seq];
-  GameInfoset infoset = p_data.SF.GetInfoset(p, seq);
 
   if (seq == 1) {
     return 1.0;
   }
-  else if (act < p_data.support.NumActions(infoset)) {
+  else if (act < p_data.support.NumActions(p_data.SF.GetInfoset(p, isetrow))) {
     return x[varno];
   }
   else {    
     double value = 0.0;
-    for (int j = 1; j < seq; j++) {
-      if (p_data.SF.Constraints(p)(isetrow,j) == Rational(-1)) {
-	value -= NumProbOfSequence(p_data, p, j, x);
-      }
-      else if (p_data.SF.Constraints(p)(isetrow,j) == Rational(1)) {
-	value += NumProbOfSequence(p_data, p, j, x);
-      }
+    value += NumProbOfSequence(p_data, p, 
+			       p_data.SF.GetParentSequence(p, isetrow), x);
+    for (int a = 1; a < act; a++) {
+      value -= NumProbOfSequence(p_data, p, 
+				 p_data.SF.GetSequence(p, isetrow, a), x);
     }
     return value;
   }
 }
 
+Array<int>
+NumSequences(const ProblemData &p_data)
+{
+  Array<int> lengths(p_data.SF.NumPlayers());
+  for (int pl = 1; pl <= p_data.SF.NumPlayers(); pl++) {
+    lengths[pl] = p_data.SF.NumSequences(pl);
+  }
+  return lengths;
+}
+
 PVector<double> 
 SeqFormVectorFromSolFormVector(const ProblemData &p_data, 
 			       const Vector<double> &v)
 {
-  PVector<double> x(p_data.SF.NumSequences());
+  PVector<double> x(NumSequences(p_data));
 
   for (int i = 1; i <= p_data.support.GetGame()->NumPlayers(); i++) {
-    for (int j = 1; j <= p_data.SF.NumSequences()[i]; j++) {
+    for (int j = 1; j <= p_data.SF.NumSequences(i); j++) {
       x(i,j) = NumProbOfSequence(p_data, i, j, v);
     }
   }
@@ -247,6 +251,24 @@ SeqFormVectorFromSolFormVector(const ProblemData &p_data,
   return x;
 }
 
+MixedBehaviorProfile<double>
+ToBehav(const ProblemData &p_data, const PVector<double> &x)
+{
+  MixedBehaviorProfile<double> b(p_data.support);
+  b = 0.0;
+
+  for (int pl = 1; pl <= p_data.SF.NumPlayers(); pl++) {
+    for (int seq = 2; seq <= p_data.SF.NumSequences(pl); seq++) {
+      int isetrow = p_data.SF.GetSequenceInfoset(pl, seq);
+      int parent = p_data.SF.GetParentSequence(pl, isetrow);
+      b(pl, p_data.SF.GetInfoset(pl, isetrow)->GetNumber(),
+	p_data.SF.GetSequenceAction(pl, seq)) = 
+	(x(pl, parent) > 0.0) ? x(pl, seq) / x(pl, parent) : 0.0;
+    }
+  }
+  return b;
+}
+
 bool ExtendsToNash(const MixedBehaviorProfile<double> &bs) 
 {
   algExtendsToNash algorithm;
@@ -301,7 +323,7 @@ SolveSupport(const BehaviorSupportProfile &p_support, bool &p_isSingular)
   List<MixedBehaviorProfile<double> > solutions;
   for (int k = 1; k <= solutionlist.Length(); k++) {
     PVector<double> y = SeqFormVectorFromSolFormVector(data, solutionlist[k]);
-    MixedBehaviorProfile<double> sol(data.SF.ToBehav(y));
+    MixedBehaviorProfile<double> sol(ToBehav(data, y));
     if (ExtendsToNash(sol)) { 
       solutions.Append(sol);
     }
@@ -314,10 +336,10 @@ SolveSupport(const BehaviorSupportProfile &p_support, bool &p_isSingular)
 PVector<double> 
 SeqFormProbsFromSolVars(const ProblemData &p_data, const Vector<double> &v)
 {
-  PVector<double> x(p_data.SF.NumSequences());
+  PVector<double> x(NumSequences(p_data));
 
   for(int pl=1;pl<=p_data.support.GetGame()->NumPlayers();pl++) 
-    for(int seq=1;seq<=p_data.SF.NumSequences()[pl];seq++)
+    for(int seq=1;seq<=p_data.SF.NumSequences(pl);seq++)
       x(pl,seq) = NumProbOfSequence(p_data, pl,seq,v);
 
   return x;
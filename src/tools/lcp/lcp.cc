@@ -26,6 +26,8 @@
 #include <cerrno>
 #include <unistd.h>
 #include <getopt.h>
+#include <algorithm>
+#include <thread>
 #include "gambit/gambit.h"
 #include "gambit/nash/lcp.h"
 
@@ -55,6 +57,8 @@ void PrintHelp(char *progname)
   std::cerr << "                   (default is to find all accessible equilbria\n";
   std::cerr << "  -r DEPTH         terminate recursion at DEPTH\n";
   std::cerr << "                   (only if number of equilibria sought is not 1)\n";
+  std::cerr << "  -t THREADS       follow paths in THREADS threads\n";
+  std::cerr << "                   (default is 1; 0 uses one per processor)\n";
   std::cerr << "  -D               print detailed information about equilibria\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
@@ -68,15 +72,16 @@ int main(int argc, char *argv[])
   int c;
   bool useFloat = false, useStrategic = false, bySubgames = false, quiet = false;
   bool printDetail = false;
-  int numDecimals = 6, stopAfter = 0, maxDepth = 0;
+  int numDecimals = 6, stopAfter = 0, maxDepth = 0, numThreads = 1;
 
   int long_opt_index = 0;
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
     { "version", 0, NULL, 'v'  },
+    { "threads", 1, NULL, 't'  },
     { 0,    0,    0,    0   }
   };
-  while ((c = getopt_long(argc, argv, "d:DvhqSPe:r:", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:DvhqSPe:r:t:", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -102,6 +107,12 @@ int main(int argc, char *argv[])
     case 'S':
       useStrategic = true;
       break;
+    case 't':
+      numThreads = atoi(optarg);
+      if (numThreads <= 0) {
+	numThreads = std::max(1U, std::thread::hardware_concurrency());
+      }
+      break;
     case 'P':
       bySubgames = true;
       break;
@@ -148,7 +159,7 @@ int main(int argc, char *argv[])
 	  renderer = new MixedStrategyCSVRenderer<double>(std::cout, numDecimals);
 	}
 	NashLcpStrategySolver<double> algorithm(stopAfter, maxDepth,
-						renderer);
+						renderer, numThreads);
 	algorithm.Solve(game);
       }
       else {
@@ -160,7 +171,7 @@ int main(int argc, char *argv[])
 	  renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
 	}
 	NashLcpStrategySolver<Rational> algorithm(stopAfter, maxDepth,
-						  renderer);
+						  renderer, numThreads);
 	algorithm.Solve(game);
       }
     }
@@ -176,7 +187,8 @@ int main(int argc, char *argv[])
 	    renderer = new BehavStrategyCSVRenderer<double>(std::cout, 
 							    numDecimals);
 	  }
-	  NashLcpBehaviorSolver<double> algorithm(stopAfter, maxDepth, renderer);
+	  NashLcpBehaviorSolver<double> algorithm(stopAfter, maxDepth, renderer,
+						  numThreads);
 	  algorithm.Solve(game);
 	}
 	else {
@@ -187,14 +199,16 @@ int main(int argc, char *argv[])
 	  else {
 	    renderer = new BehavStrategyCSVRenderer<Rational>(std::cout);
 	  }
-	  NashLcpBehaviorSolver<Rational> algorithm(stopAfter, maxDepth, renderer);
+	  NashLcpBehaviorSolver<Rational> algorithm(stopAfter, maxDepth,
+						    renderer, numThreads);
 	  algorithm.Solve(game);
 	}
       }
       else {
 	if (useFloat) {
 	  shared_ptr<BehavSolver<double> > stage = 
-	    new NashLcpBehaviorSolver<double>(stopAfter, maxDepth);
+	    new NashLcpBehaviorSolver<double>(stopAfter, maxDepth, 0,
+					      numThreads);
 	  shared_ptr<StrategyProfileRenderer<double> > renderer;
 	  if (printDetail)  {
 	    renderer = new BehavStrategyDetailRenderer<double>(std::cout,
@@ -209,7 +223,8 @@ int main(int argc, char *argv[])
 	}
 	else {
 	  shared_ptr<BehavSolver<Rational> > stage = 
-	    new NashLcpBehaviorSolver<Rational>(stopAfter, maxDepth);
+	    new NashLcpBehaviorSolver<Rational>(stopAfter, maxDepth, 0,
+						numThreads);
 	  shared_ptr<StrategyProfileRenderer<Rational> > renderer;
 	  if (printDetail)  {
 	    renderer = new BehavStrategyDetailRenderer<Rational>(std::cout,
@@ -54,6 +54,7 @@ private:
 double AgentLyapunovFunction::Value(const Vector<double> &v) const
 {
   static_cast<Vector<double> &>(m_profile).operator=(v);
+  m_profile.Invalidate();
   return m_profile.GetLiapValue();
 }
 
@@ -62,13 +63,31 @@ bool AgentLyapunovFunction::Gradient(const Vector<double> &x,
 {
   const double DELTA = .00001;
   static_cast<Vector<double> &>(m_profile).operator=(x);
-  for (int i = 1; i <= x.Length(); i++) {
-    m_profile[i] += DELTA;
-    double value = m_profile.GetLiapValue();
-    m_profile[i] -= 2.0 * DELTA;
-    value -= m_profile.GetLiapValue();
-    m_profile[i] += DELTA;
-    grad[i] = value / (2.0 * DELTA);
+  m_profile.Invalidate();
+  // Each coordinate belongs to a single information set, so the profile
+  // can be updated incrementally as it is perturbed
+  const BehaviorSupportProfile &support = m_profile.GetSupport();
+  int i = 1;
+  for (int pl = 1; pl <= m_game->NumPlayers(); pl++) {
+    GamePlayer player = m_game->GetPlayer(pl);
+    for (int iset = 1; iset <= player->NumInfosets(); iset++) {
+      GameInfoset infoset = player->GetInfoset(iset);
+      Vector<double> probs(support.NumActions(pl, iset));
+      for (int act = 1; act <= probs.Length(); act++) {
+	probs[act] = x[i + act - 1];
+      }
+      for (int act = 1; act <= probs.Length(); act++, i++) {
+	probs[act] += DELTA;
+	m_profile.SetActionProbs(infoset, probs);
+	double value = m_profile.GetLiapValue();
+	probs[act] -= 2.0 * DELTA;
+	m_profile.SetActionProbs(infoset, probs);
+	value -= m_profile.GetLiapValue();
+	probs[act] += DELTA;
+	grad[i] = value / (2.0 * DELTA);
+      }
+      m_profile.SetActionProbs(infoset, probs);
+    }
   }
   Project(grad, m_game->NumInfosets());
   return true;
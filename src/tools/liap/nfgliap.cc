@@ -49,37 +49,46 @@ private:
   double Value(const Vector<double> &) const;
   bool Gradient(const Vector<double> &, Vector<double> &) const;
 
-  double LiapDerivValue(int, int, const MixedStrategyProfile<double> &) const;
+  double LiapDerivValue(int, int, const MixedStrategyProfile<double> &,
+			const Matrix<double> &, const Array<Matrix<double> > &,
+			const Vector<double> &) const;
 };
 
+//
+// The derivative of the Lyapunov function with respect to the probability
+// of the j1'th strategy in the profile, which belongs to player i1.
+// The payoffs to each strategy, their cross-derivatives, and the payoff
+// to each player are computed once by the caller and shared by all
+// strategies.
+//
 double 
 StrategicLyapunovFunction::LiapDerivValue(int i1, int j1,
-					  const MixedStrategyProfile<double> &p) const
+					  const MixedStrategyProfile<double> &p,
+					  const Matrix<double> &p_values,
+					  const Array<Matrix<double> > &p_derivs,
+					  const Vector<double> &p_payoffs) const
 {
-  GameStrategy wrt_strategy = m_game->Players()[i1]->Strategies()[j1];
   double x = 0.0;
-  for (int i = 1; i <= m_game->NumPlayers(); i++)  {
+  for (int i = 1, j = 1; i <= m_game->NumPlayers(); i++)  {
     double psum = 0.0;
     GamePlayer player = m_game->Players()[i];
-    for (int j = 1; j <= player->NumStrategies(); j++)  {
-      GameStrategy strategy = player->Strategies()[j];
-      psum += p[strategy];
-      double x1 = p.GetPayoff(strategy) - p.GetPayoff(i);
+    for (int st = 1; st <= player->NumStrategies(); st++, j++)  {
+      psum += p[j];
+      double x1 = p_values(i, j) - p_payoffs[i];
       if (i1 == i) {
 	if (x1 > 0.0)
-	  x -= x1 * p.GetPayoffDeriv(i, wrt_strategy);
+	  x -= x1 * p_values(i, j1);
       }
       else if (x1 > 0.0) {
-	x += x1 * (p.GetPayoffDeriv(i, strategy, wrt_strategy) - 
-		   p.GetPayoffDeriv(i, wrt_strategy));
+	x += x1 * (p_derivs[i](j, j1) - p_values(i, j1));
       }
     }
     if (i == i1)  {
       x += 100.0 * (psum - 1.0);
     }
   }
-  if (p[wrt_strategy] < 0.0) {
-    x += p[wrt_strategy];
+  if (p[j1] < 0.0) {
+    x += p[j1];
   }
   return 2.0 * x;
 }
@@ -88,9 +97,17 @@ bool
 StrategicLyapunovFunction::Gradient(const Vector<double> &v, Vector<double> &d) const
 {
   static_cast<Vector<double> &>(m_profile).operator=(v);
+  Matrix<double> values;
+  Array<Matrix<double> > derivs;
+  m_profile.GetPayoffDerivs(values, &derivs);
+  Vector<double> payoffs(m_game->NumPlayers());
+  for (int pl = 1; pl <= m_game->NumPlayers(); pl++) {
+    payoffs[pl] = m_profile.GetPayoff(pl);
+  }
+
   for (int pl = 1, ii = 1; pl <= m_game->NumPlayers(); pl++) {
-    for (int st = 1; st <= m_game->Players()[pl]->Strategies().size(); st++) {
-      d[ii++] = LiapDerivValue(pl, st, m_profile);
+    for (int st = 1; st <= m_game->Players()[pl]->Strategies().size(); st++, ii++) {
+      d[ii] = LiapDerivValue(pl, ii, m_profile, values, derivs, payoffs);
     }
   }
   Project(d, m_game->NumStrategies());
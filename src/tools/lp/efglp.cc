@@ -32,99 +32,52 @@ using namespace Gambit;
 
 template <class T> class NashLpBehavSolver<T>::GameData {
 public:
+  SequenceForm sf;
   int ns1, ns2, ni1, ni2;
   Rational minpay;
-  PVector<int> infosetIndex, infosetOffset;
   
   GameData(const BehaviorSupportProfile &);
 
-  void BuildConstraintMatrix(const BehaviorSupportProfile &,
-			     Matrix<T> &, const GameNode &, const T &,
-			     int, int, int, int);
-  void GetBehavior(const BehaviorSupportProfile &, MixedBehaviorProfile<T> &v,
-		   const Array<T> &, const Array<T> &,
-		   const GameNode &, int, int);
+  void BuildConstraintMatrix(Matrix<T> &);
+  void GetBehavior(MixedBehaviorProfile<T> &v,
+		   const Array<T> &, const Array<T> &);
 };
 
 template <class T>
 NashLpBehavSolver<T>::GameData::GameData(const BehaviorSupportProfile &p_support)
-  : infosetIndex(p_support.GetGame()->NumInfosets()), 
-    infosetOffset(p_support.GetGame()->NumInfosets())
+  : sf(p_support)
 {
-  infosetIndex = 0;
-  infosetOffset = 0;
-  ns1 = p_support.NumSequences(1);
-  ns2 = p_support.NumSequences(2);
+  ns1 = sf.NumSequences(1);
+  ns2 = sf.NumSequences(2);
   ni1 = p_support.GetGame()->GetPlayer(1)->NumInfosets()+1;  
   ni2 = p_support.GetGame()->GetPlayer(2)->NumInfosets()+1; 
-  p_support.ReachableInfosets(p_support.GetGame()->GetRoot(), infosetIndex);
-  for (int iset = 1, offset = 1, index = 1; iset < ni1; iset++) {
-    if (infosetIndex(1, iset) > 0) {
-      infosetOffset(1, iset) = offset;
-      infosetIndex(1, iset) = index++;
-      offset += p_support.NumActions(1, iset);
-    }
-  }
-  for (int iset = 1, offset = 1, index = 1; iset < ni2; iset++) {
-    if (infosetIndex(2, iset) > 0) {
-      infosetOffset(2, iset) = offset;
-      infosetIndex(2, iset) = index++;
-      offset += p_support.NumActions(2, iset);
-    }
-  }
   minpay = p_support.GetGame()->GetMinPayoff();
 }
 
 //
-// Recursively fills the constraint matrix A for the subtree rooted at 'n'.
+// Fills the constraint matrix A from the sequence form.  Payoffs are
+// shifted to be nonnegative, by subtracting the smallest payoff from
+// each outcome.
 //
 template <class T> void
-NashLpBehavSolver<T>::GameData::BuildConstraintMatrix(const BehaviorSupportProfile &p_support,
-						      Matrix<T> &A, 
-						      const GameNode &n, 
-						      const T &prob,
-						      int s1, int s2, 
-						      int i1, int i2)
+NashLpBehavSolver<T>::GameData::BuildConstraintMatrix(Matrix<T> &A)
 {
-  GameOutcome outcome = n->GetOutcome();
-  if (outcome) {
-    A(s1,s2) += 
-      (T) (Rational(prob) * outcome->GetPayoff<Rational>(1) - minpay);
+  for (int e = 1; e <= sf.NumEntries(); e++) {
+    A(sf.GetEntrySequence(e, 1), sf.GetEntrySequence(e, 2)) = 
+      (T) (sf.GetEntryPayoff(e, 1) - sf.GetEntryProb(e) * minpay);
   }
 
-  if (n->NumChildren() == 0) {
-    // Terminal node, recursion ends
-    return;
-  }
-
-  if (n->GetPlayer()->IsChance()) {
-    GameInfoset infoset = n->GetInfoset();
-    for (int i = 1; i <= n->NumChildren(); i++) {
-      BuildConstraintMatrix(p_support, A, n->GetChild(i),
-			    prob * infoset->GetActionProb(i, (T) 0),
-			    s1, s2, i1, i2);
-    }
-  }
-  else if (n->GetPlayer()->GetNumber() == 1) {
-    i1 = infosetIndex(1, n->GetInfoset()->GetNumber());
-    int snew = infosetOffset(1, n->GetInfoset()->GetNumber());
-    A(s1, ns2+i1+1) = (T) 1;
-    for (int i = 1; i <= p_support.NumActions(n->GetInfoset()); i++) {
-      A(snew+i, ns2+i1+1) = (T) -1;
-      BuildConstraintMatrix(p_support, A, 
-			    n->GetChild(p_support.GetAction(n->GetInfoset(), i)->GetNumber()),
-			    prob, snew+i, s2, i1, i2);
+  for (int i1 = 1; i1 <= sf.NumInfosets(1); i1++) {
+    A(sf.GetParentSequence(1, i1), ns2+i1+1) = (T) 1;
+    for (int i = 1; i <= sf.GetSupport().NumActions(sf.GetInfoset(1, i1)); i++) {
+      A(sf.GetSequence(1, i1, i), ns2+i1+1) = (T) -1;
     }
   }
-  else {  // Must be player 2
-    i2 = infosetIndex(2, n->GetInfoset()->GetNumber());
-    int snew = infosetOffset(2, n->GetInfoset()->GetNumber());
-    A(ns1+i2+1, s2) = (T) -1;
-    for (int i = 1; i <= p_support.NumActions(n->GetInfoset()); i++) {
-      A(ns1+i2+1, snew+i) = (T) 1;
-      BuildConstraintMatrix(p_support, A, 
-			    n->GetChild(p_support.GetAction(n->GetInfoset(), i)->GetNumber()),
-			    prob, s1, snew+i, i1, i2);
+
+  for (int i2 = 1; i2 <= sf.NumInfosets(2); i2++) {
+    A(ns1+i2+1, sf.GetParentSequence(2, i2)) = (T) -1;
+    for (int i = 1; i <= sf.GetSupport().NumActions(sf.GetInfoset(2, i2)); i++) {
+      A(ns1+i2+1, sf.GetSequence(2, i2, i)) = (T) 1;
     }
   }
 }
@@ -173,59 +126,31 @@ NashLpBehavSolver<T>::SolveLP(const Matrix<T> &A,
 }
 
 //
-// Recursively construct the behavior profile from the sequence form
-// solution represented by 'p_primal' (containing player 2's
-// sequences) and 'p_dual' (containing player 1's sequences).
+// Construct the behavior profile from the sequence form solution
+// represented by 'p_primal' (containing player 2's sequences) and
+// 'p_dual' (containing player 1's sequences).
 //
 // Any information sets not reached with positive probability have
 // their action probabilities set to zero.
 //
 template <class T> void
-NashLpBehavSolver<T>::GameData::GetBehavior(const BehaviorSupportProfile &p_support,
-					    MixedBehaviorProfile<T> &v,
+NashLpBehavSolver<T>::GameData::GetBehavior(MixedBehaviorProfile<T> &v,
 					    const Array<T> &p_primal, 
-					    const Array<T> &p_dual,
-					    const GameNode &n,
-					    int s1, int s2)
+					    const Array<T> &p_dual)
 {
-  if (n->NumChildren() == 0) {
-    return;
-  }
-
-  if (n->GetPlayer()->IsChance()) {
-    for (int i = 1; i <= n->NumChildren(); i++) {
-      GetBehavior(p_support, v, p_primal, p_dual,
-		  n->GetChild(i), s1, s2);
-    }
-  }
-  else if (n->GetPlayer()->GetNumber() == 2) {
-    int inf = infosetIndex(2, n->GetInfoset()->GetNumber());
-    int snew = infosetOffset(2, n->GetInfoset()->GetNumber());
-    for (int i = 1; i <= p_support.NumActions(n->GetInfoset()); i++) {
-      if (p_primal[s1] > (T) 0) {
-	v(2,inf,i) = p_primal[snew+i] / p_primal[s1];
-      } 
-      else {
-	v(2,inf,i) = (T) 0;
-      }
-      GetBehavior(p_support, v, p_primal, p_dual,
-		  n->GetChild(p_support.GetAction(n->GetInfoset(), i)->GetNumber()),
-		  snew+i, s2);
-    }
-  }
-  else {  // Must be player 1
-    int inf = infosetIndex(1, n->GetInfoset()->GetNumber());
-    int snew = infosetOffset(1, n->GetInfoset()->GetNumber());
-    for (int i = 1; i <= p_support.NumActions(n->GetInfoset()); i++) {
-      if (p_dual[s2] > (T) 0) {
-	v(1,inf,i) = p_dual[snew+i] / p_dual[s2];
-      }
-      else {
-	v(1,inf,i) = (T) 0;
+  for (int pl = 1; pl <= 2; pl++) {
+    const Array<T> &x = (pl == 1) ? p_dual : p_primal;
+    for (int inf = 1; inf <= sf.NumInfosets(pl); inf++) {
+      GameInfoset infoset = sf.GetInfoset(pl, inf);
+      int s = sf.GetParentSequence(pl, inf);
+      for (int i = 1; i <= sf.GetSupport().NumActions(infoset); i++) {
+	if (x[s] > (T) 0) {
+	  v(pl,infoset->GetNumber(),i) = x[sf.GetSequence(pl, inf, i)] / x[s];
+	}
+	else {
+	  v(pl,infoset->GetNumber(),i) = (T) 0;
+	}
       }
-      GetBehavior(p_support, v, p_primal, p_dual,
-		  n->GetChild(p_support.GetAction(n->GetInfoset(), i)->GetNumber()),
-		  s1, snew+i);
     }
   }
 }
@@ -250,7 +175,7 @@ NashLpBehavSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
 
   Gambit::linalg::BFS<T> cbfs;
   
-  GameData data(p_support.GetGame());
+  GameData data(p_support);
 
   Matrix<T> A(1, data.ns1 + data.ni2, 1, data.ns2 + data.ni1);
   Vector<T> b(1, data.ns1 + data.ni2);
@@ -260,8 +185,7 @@ NashLpBehavSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
   b = (T) 0;
   c = (T) 0;
 
-  data.BuildConstraintMatrix(p_support, A, p_support.GetGame()->GetRoot(), 
-			     (T) 1, 1, 1, 0, 0);
+  data.BuildConstraintMatrix(A);
   A(1, data.ns2 + 1) = (T) -1;
   A(data.ns1 + 1, 1) = (T) 1;
 
@@ -272,8 +196,7 @@ NashLpBehavSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
   List<MixedBehaviorProfile<T> > solution;
   if (SolveLP(A, b, c, data.ni2, primal, dual)) {
     MixedBehaviorProfile<T> profile(p_support);
-    data.GetBehavior(p_support, profile, primal, dual,
-		     p_support.GetGame()->GetRoot(), 1, 1);
+    data.GetBehavior(profile, primal, dual);
     profile.UndefinedToCentroid();
     this->m_onEquilibrium->Render(profile);
     solution.push_back(profile);
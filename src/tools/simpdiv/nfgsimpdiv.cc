@@ -87,6 +87,8 @@ void PrintHelp(char *progname)
   std::cerr << "With no options, computes one approximate Nash equilibrium.\n\n";
 
   std::cerr << "Options:\n";
+  std::cerr << "  -d DECIMALS      subdivide using floating-point arithmetic, checking\n";
+  std::cerr << "                   the result exactly; display results with DECIMALS digits\n";
   std::cerr << "  -g MULT          granularity of grid refinement at each step (default is 2)\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -r DENOM         generate random starting points with denominator DENOM\n";
@@ -104,8 +106,8 @@ int main(int argc, char *argv[])
   opterr = 0;
   std::string startFile;
   bool useRandom = false;
-  int randDenom = 1, gridResize = 2, stopAfter = 1;
-  bool verbose = false, quiet = false;
+  int randDenom = 1, gridResize = 2, stopAfter = 1, numDecimals = 6;
+  bool useFloat = false, verbose = false, quiet = false;
 
   int long_opt_index = 0;
   struct option long_options[] = {
@@ -119,6 +121,10 @@ int main(int argc, char *argv[])
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
+    case 'd':
+      useFloat = true;
+      numDecimals = atoi(optarg);
+      break;
     case 'g':
       gridResize = atoi(optarg);
       break;
@@ -191,11 +197,20 @@ int main(int argc, char *argv[])
       }
     }
     for (int i = 1; i <= starts.size(); i++) {
-      shared_ptr<StrategyProfileRenderer<Rational> > renderer;
-      renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
-      NashSimpdivStrategySolver algorithm(gridResize, 0, verbose,
-					  renderer);
-      algorithm.Solve(starts[i]);
+      if (useFloat) {
+	shared_ptr<StrategyProfileRenderer<double> > renderer;
+	renderer = new MixedStrategyCSVRenderer<double>(std::cout, numDecimals);
+	NashSimpdivStrategySolver<double> algorithm(gridResize, 0, verbose,
+						    renderer);
+	algorithm.Solve(starts[i]);
+      }
+      else {
+	shared_ptr<StrategyProfileRenderer<Rational> > renderer;
+	renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
+	NashSimpdivStrategySolver<Rational> algorithm(gridResize, 0, verbose,
+						      renderer);
+	algorithm.Solve(starts[i]);
+      }
     }
     return 0;
   }